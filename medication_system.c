@@ -1,47 +1,178 @@
+#if defined(__linux__) && !defined(_GNU_SOURCE)
+#define _GNU_SOURCE // accept4() for the IPC server mode
+#endif
+
 #include <stdio.h>
 #include <stdlib.h>
 #include <string.h>
+#include <ctype.h>
+#include <limits.h>
+#include <stdint.h>
+#include <time.h>
+
+#ifdef __linux__
+#include <errno.h>
+#include <signal.h>
+#include <stdarg.h>
+#include <unistd.h>
+#include <sys/epoll.h>
+#include <sys/socket.h>
+#include <sys/un.h>
+#endif
+
+// C99 restrict lets the forecast kernel vectorize; C++ compilers spell it __restrict
+#ifdef __cplusplus
+#define RESTRICT __restrict
+#else
+#define RESTRICT restrict
+#endif
 
 // ===== STRUCTURE DEFINITIONS =====
 
+#define NAME_SIZE 50 // Size of Medication.name, also the longest fuzzy search key
+
 typedef struct {
     int refillsRemaining;
     char nextRefillDate[12];
+    int tabletsPerRefill; // Tablets/capsules supplied each time the prescription is refilled
 } RefillInfo; // Structure to hold refill information
 
+typedef struct {
+    int dosesPerDay;      // 0 when taken only as needed (no forecast)
+    float tabletsPerDose;
+} DosingSchedule; // Structure to hold how the medication is taken
+
 typedef struct {
     int medicationId;
-    char name[50];
+    char name[NAME_SIZE];
     char dosage[20];
     int quantity;
     float price;
     RefillInfo refill; // Nested structure (1)
+    DosingSchedule schedule;
 } Medication; // Structure to hold medication information
 
+// Stable reference to a medication in the store. The generation changes whenever
+// the slot is released, so a handle kept after a delete simply stops resolving.
+typedef struct {
+    unsigned int index;
+    unsigned int generation;
+} MedicationHandle; // 8-byte reference used by the stack and the queue
+
 // (HAMZAH)'s Linked List Node Structure
 typedef struct MedicationNode {
     Medication med; // Nested structure (2) 
+    MedicationHandle handle; // Handle that refers back to this node
     struct MedicationNode* next;
 } MedicationNode; // Linked list node structure to hold medication data
 
+typedef struct {
+    MedicationNode* node;     // Node owning this slot, NULL when the slot is free
+    unsigned int generation;  // Bumped on release so old handles go stale
+    unsigned int nextFree;    // Next free slot index when this slot is free
+} MedicationSlot; // One entry of the handle table
+
+typedef struct {
+    MedicationSlot* slots;
+    unsigned int capacity;
+    unsigned int used;        // Slots handed out at least once
+    unsigned int freeHead;    // Head of the free slot list (NO_FREE_SLOT if empty)
+} MedicationStore; // Handle table mapping handles to linked list nodes
+
+#define NO_FREE_SLOT 0xFFFFFFFFu
+#define INITIAL_SLOT_CAPACITY 16
+#define FUZZY_TAIL_FRACTION 64 // Repack the BK-tree once unpacked names pass 1/64 of it
+
+#define ID_ENTRY_EMPTY 0
+#define ID_ENTRY_USED 1
+#define ID_ENTRY_DELETED 2 // Tombstone so probe chains stay intact after a removal
+typedef struct {
+    int medicationId;
+    int state;
+    MedicationHandle handle;
+} MedicationIdEntry; // One slot of the ID index
+
+typedef struct {
+    MedicationIdEntry* entries;
+    unsigned int capacity;    // Always a power of two (or 0)
+    unsigned int count;       // Live IDs
+    unsigned int deleted;     // Tombstones, reclaimed when the table is rehashed
+} MedicationIdIndex; // Open-addressing hash table from medication ID to handle
+
+typedef struct {
+    MedicationHandle handle;  // Medication this entry was built from (may go stale after delete)
+    char key[NAME_SIZE];      // Lower-cased name used for distance calculations
+    int keyLength;
+    int distance;             // Edit distance to the parent node
+    int firstChild;           // Index of the first child, -1 if none
+    int nextSibling;          // Next child of the same parent, -1 if none (build tree only)
+    int childCount;           // Number of children stored from firstChild on (packed tree only)
+} FuzzyNode; // BK-tree node over medication names
+
+typedef struct {
+    FuzzyNode* nodes;         // Build tree, children chained through nextSibling
+    int count;
+    int capacity;
+    int linkedCount;          // Nodes [0, linkedCount) are linked into the tree; the rest wait for a repack
+    int staleCount;           // Entries whose medication has been deleted since the last rebuild
+    FuzzyNode* packed;        // Same tree in breadth-first order, children contiguous
+    unsigned char* packedEdges; // Edge distances of the packed nodes, scanned when pruning
+    int packedCount;          // Nodes in the packed copy; nodes added since are scanned as a tail
+    int packedCapacity;
+    int* pending;             // Work list used while packing and searching
+    int pendingCapacity;
+    int dirty;                // Renamed or too many stale entries; rebuild before the next search
+} FuzzyIndex; // BK-tree over medication names for typo-tolerant search
+
+typedef struct {
+    MedicationHandle handle;
+    int distance;
+} FuzzyMatch; // One ranked fuzzy search result
+
 #define STACK_SIZE 20 // (BA NAFEA) Stack size for medication history
 typedef struct {
-    Medication items[STACK_SIZE]; // Array of Medication structures (Nested structure 3)
+    MedicationHandle items[STACK_SIZE]; // Handles to medications in the store (Nested structure 3)
     int top;
 } MedicationStack; // Stack structure to hold medication history
 
 #define QUEUE_SIZE 20 // (BIN ISMAIL) Queue size for refill alerts
 typedef struct {
-    Medication items[QUEUE_SIZE]; // Array of Medication structures (Nested structure 4) 
+    MedicationHandle items[QUEUE_SIZE]; // Handles to medications in the store (Nested structure 4) 
     int front;
     int rear;
     int count;
 } RefillQueue; // Queue structure to hold refill alerts
 
+#define NO_FORECAST -1           // Projected day for medications without a dosing schedule
+#define MAX_FORECAST_DAYS 36500  // Projections are capped at 100 years
+#define FORECAST_ALERT_DAYS 7    // Run-outs within this many days are queued as refill alerts
+#define FORECAST_PRESCRIPTION_DAYS 14 // Refills used up within this many days need a new prescription
+#define FORECAST_REPORT_ROWS QUEUE_SIZE // Soonest run-outs listed (and considered for alerts) per run
+typedef struct {
+    int count;
+    int capacity;
+    MedicationHandle* handles;  // Medication each row was gathered from
+    float* quantity;            // Tablets on hand
+    float* dailyUse;            // Tablets taken per day (0 without a schedule)
+    float* refillSupply;        // Tablets still obtainable through remaining refills
+    int* runOutDay;             // Days from today until the tablets on hand run out
+    int* exhaustionDay;         // Days from today until the refills are used up as well
+    int today;                  // Today's day number (days since 01/01/1970), read once per run
+} ConsumptionForecast; // Structure of arrays so the projection runs as one vectorizable pass
+
+// (RAYAN) Sorting categories offered in the sort menu
+#define SORT_BY_NAME 1
+#define SORT_BY_PRICE 2
+#define SORT_BY_QUANTITY 3
+
 // ===== GLOBAL VARIABLES =====
 MedicationNode* medicationList = NULL; // Head of the linked list (HAMZAH)
 MedicationStack medicationHistory; // Stack to hold medication history (BA NAFEA)
 RefillQueue refillAlerts; // Queue to hold refill alerts (BIN ISMAIL)
+MedicationStore medicationStore; // Handle table for stable medication references (HAMZAH)
+MedicationIdIndex medicationIdIndex; // Medication ID to handle lookups in O(1) (HAMZAH)
+FuzzyIndex fuzzyIndex; // BK-tree name index for fuzzy search (RAYAN)
+ConsumptionForecast consumptionForecast; // Buffers reused by every forecast run (BIN ISMAIL)
 
 // ===== FUNCTION DECLARATIONS =====
 void initializeSystem();
@@ -52,32 +183,68 @@ void displayMedication(Medication med);         // Here, a Medication structure
 
 // Linked List Functions (HAMZAH)
 // These functions handle medication management using a linked list structure
-void insertMedication(Medication med);        // Here, a Medication structure is passed by value be inserted in the linked list (Passing 2)
+MedicationHandle insertMedication(Medication med); // Here, a Medication structure is passed by value be inserted in the linked list (Passing 2)
+MedicationHandle storeMedication(Medication med);  // Same as insertMedication without the console messages
 void deleteMedication(int medicationId);
+MedicationNode* unlinkMedication(int medicationId); // Detaches a node from the list without freeing it
 void updateMedication(int medicationId);
 void displayMedicationList();
 
+// Handle Functions (HAMZAH)
+// These functions give the stack and queue stable references into the linked list
+MedicationHandle allocateHandle(MedicationNode* node);
+void releaseHandle(MedicationHandle handle);
+Medication* resolveHandle(MedicationHandle handle);
+int indexMedicationId(int medicationId, MedicationHandle handle);
+void unindexMedicationId(int medicationId);
+Medication* findMedicationById(int medicationId);
+
 // Stack Functions (BA NAFEA)
 // These functions handle medication history using a stack structure
-void pushMedication(Medication med);        // Here, a Medication structure is passed to be added to the stack (Passing 3)
-Medication popMedication(); 
+void pushMedication(MedicationHandle handle); // Here, a handle to a Medication structure is passed to be added to the stack (Passing 3)
+MedicationHandle popMedication(); 
 void displayMedicationHistory();
 int isStackEmpty();
 
 // Queue Functions (BIN ISMAIL)
 // These functions handle refill alerts using a queue structure
-void enqueueMedication(Medication med);     // Here, a Medication structure is passed to be added to the queue (Passing 4)
-Medication dequeueMedication();
+void enqueueMedication(MedicationHandle handle); // Here, a handle to a Medication structure is passed to be added to the queue (Passing 4)
+MedicationHandle dequeueMedication();
 void displayRefillAlerts();
 int isQueueEmpty();
 int isQueueFull();
+int dropStaleAlerts();
+int isAlertQueued(MedicationHandle handle);
+
+// Forecast Functions (BIN ISMAIL)
+// These functions project when each medication runs out and queue refill alerts for them
+int gatherForecastInputs(ConsumptionForecast* forecast);
+void projectConsumption(int n, const float* RESTRICT quantity, const float* RESTRICT dailyUse,
+                        const float* RESTRICT refillSupply, int* RESTRICT runOutDay, int* RESTRICT exhaustionDay);
+int selectSoonestDays(const ConsumptionForecast* forecast, const int* days, int window, int rows[], int maxRows, int* dueCount);
+int queueForecastAlert(MedicationHandle handle);
+int currentDayNumber();
+void formatForecastDate(int today, int daysFromToday, char* buffer, size_t size);
+void forecastRefillAlerts();
+void runForecastBenchmark(int n); // Times forecastRefillAlerts over n synthetic medications in the store
 
 // Search and Sort Functions (RAYAN)
 void searchMedication();
 void linearSearch(char* searchName);
+void fuzzySearch(char* searchName, int maxDistance);
+int editDistance(const uint64_t peq[256], int patternLength, const char* text); // Myers bit-parallel Levenshtein distance
+void addToFuzzyIndex(MedicationNode* node);
+void linkFuzzyNode(int index);
+void removeFromFuzzyIndex();
+void renameInFuzzyIndex(MedicationNode* node);
+void rebuildFuzzyIndex();
+int packFuzzyIndex();
+int appendFuzzyMatch(FuzzyMatch** matches, int* matchCount, int* matchCapacity, MedicationHandle handle, int distance);
 void sortMedications();
-void bubbleSort(Medication arr[], int n, int sortBy);       // Here, an array of Medication structures is passed to be sorted (Passing 5)
-void selectionSort(Medication arr[], int n, int sortBy);    // Here, an array of Medication structures is passed to be sorted (Passing 6)
+void bubbleSort(Medication arr[], int n, int sortBy, int descending);     // Here, an array of Medication structures is passed to be sorted (Passing 5)
+void selectionSort(Medication arr[], int n, int sortBy, int descending);  // Here, an array of Medication structures is passed to be sorted (Passing 6)
+void insertionSort(Medication arr[], int n, int sortBy, int descending);  // Stable alternative to selection sort
+void runSortBenchmark(int n); // Compares the specialized sort kernels against a switch-per-comparison sort
 void displaySortedMedications(Medication arr[], int n);     // Here, an array of Medication structures is passed to be displayed (Passing 7)
 
 int getMedicationCount(); // (HAMZAH) Returns the count of medications in the linked list
@@ -87,8 +254,35 @@ void populateSampleData();
 void cleanupSystem(); // Function to free allocated memory at program termination
 int isDuplicateId(int medicationId); //  Function to check if a medication ID already exists in the linked list
 
+// IPC Server Functions
+// Daemon mode that shares one medication store between terminals (Linux only)
+int runServer(const char* socketPath);
+int runLoadGenerator(const char* socketPath, int requests, int batchSize);
+
 // ===== MAIN FUNCTION =====
-int main() {
+int main(int argc, char* argv[]) {
+    // Command line modes: "--serve <socket>" runs the shared store daemon,
+    // "--loadgen <socket> [requests] [batch]" measures its throughput,
+    // "--bench-sort [count]" times the sort kernels,
+    // "--bench-forecast [count]" times the nightly consumption projection
+    if (argc >= 3 && strcmp(argv[1], "--serve") == 0) {
+        initializeSystem();
+        return runServer(argv[2]);
+    }
+    if (argc >= 3 && strcmp(argv[1], "--loadgen") == 0) {
+        int requests = argc >= 4 ? atoi(argv[3]) : 100000;
+        int batchSize = argc >= 5 ? atoi(argv[4]) : 16;
+        return runLoadGenerator(argv[2], requests, batchSize);
+    }
+    if (argc >= 2 && strcmp(argv[1], "--bench-sort") == 0) {
+        runSortBenchmark(argc >= 3 ? atoi(argv[2]) : 2000);
+        return 0;
+    }
+    if (argc >= 2 && strcmp(argv[1], "--bench-forecast") == 0) {
+        runForecastBenchmark(argc >= 3 ? atoi(argv[2]) : 1000000);
+        return 0;
+    }
+
     initializeSystem();
     populateSampleData();
     
@@ -112,8 +306,10 @@ int main() {
                 switch(listChoice) {
                     case 1: {
                         Medication newMed = createMedication();
-                        insertMedication(newMed);
-                        pushMedication(newMed);
+                        MedicationHandle handle = insertMedication(newMed);
+                        if (handle.generation != 0) {
+                            pushMedication(handle);
+                        }
                         break;
                     }
                     case 2: {
@@ -163,16 +359,25 @@ int main() {
                 switch(stackChoice) {
                     case 1:
                         if (!isStackEmpty()) {
-                            printf("Most recent medication added:\n");
-                            displayMedication(medicationHistory.items[medicationHistory.top]);
+                            Medication* recent = resolveHandle(medicationHistory.items[medicationHistory.top]);
+                            if (recent != NULL) {
+                                printf("Most recent medication added:\n");
+                                displayMedication(*recent);
+                            } else {
+                                printf("Most recent medication has since been deleted!\n");
+                            }
                         } else {
                             printf("No medication history available!\n");
                         }
                         break;
                     case 2:
                         if (!isStackEmpty()) {
-                            Medication removed = popMedication();
-                            printf("Removed from history: %s\n", removed.name);
+                            Medication* removed = resolveHandle(popMedication());
+                            if (removed != NULL) {
+                                printf("Removed from history: %s\n", removed->name);
+                            } else {
+                                printf("Removed deleted medication from history.\n");
+                            }
                         } else {
                             printf("No medication history to remove!\n");
                         }
@@ -194,7 +399,8 @@ int main() {
                 }
                 printf("\n=== QUEUE OPERATIONS (Refill Alerts) ===\n");
                 printf("1. Add Refill Alert\n2. Process Next Alert\n3. Display All Alerts\n");
-                printf("Enter choice (1-3): ");
+                printf("4. Forecast Run-Out Dates & Queue Alerts\n");
+                printf("Enter choice (1-4): ");
                 
                 int queueChoice;
                 scanf("%d", &queueChoice);
@@ -214,7 +420,7 @@ int main() {
                         int found = 0;
                         while (current != NULL) {
                             if (current->med.medicationId == id) {
-                                enqueueMedication(current->med);
+                                enqueueMedication(current->handle);
                                 printf("Refill alert added for %s\n", current->med.name);
                                 found = 1;
                                 break;
@@ -228,8 +434,12 @@ int main() {
                     }
                     case 2:
                         if (!isQueueEmpty()) {
-                            Medication processed = dequeueMedication();
-                            printf("Processed refill alert for: %s\n", processed.name);
+                            Medication* processed = resolveHandle(dequeueMedication());
+                            if (processed != NULL) {
+                                printf("Processed refill alert for: %s\n", processed->name);
+                            } else {
+                                printf("Discarded refill alert for a deleted medication.\n");
+                            }
                         } else {
                             printf("No refill alerts to process!\n");
                         }
@@ -237,6 +447,9 @@ int main() {
                     case 3:
                         displayRefillAlerts();
                         break;
+                    case 4:
+                        forecastRefillAlerts();
+                        break;
                     default:
                         printf("Invalid choice!\n");
                 }
@@ -279,6 +492,24 @@ void initializeSystem() {
     refillAlerts.front = 0;     // Access and assign to queue structure element (2)
     refillAlerts.rear = -1;     // Access and assign to queue structure element (3)
     refillAlerts.count = 0;     // Access and assign to queue structure element (4) 
+    medicationStore.slots = NULL;
+    medicationStore.capacity = 0;
+    medicationStore.used = 0;
+    medicationStore.freeHead = NO_FREE_SLOT;
+    memset(&medicationIdIndex, 0, sizeof(medicationIdIndex));
+    fuzzyIndex.nodes = NULL;
+    fuzzyIndex.count = 0;
+    fuzzyIndex.capacity = 0;
+    fuzzyIndex.linkedCount = 0;
+    fuzzyIndex.staleCount = 0;
+    fuzzyIndex.packed = NULL;
+    fuzzyIndex.packedEdges = NULL;
+    fuzzyIndex.packedCount = 0;
+    fuzzyIndex.packedCapacity = 0;
+    fuzzyIndex.pending = NULL;
+    fuzzyIndex.pendingCapacity = 0;
+    fuzzyIndex.dirty = 0;
+    memset(&consumptionForecast, 0, sizeof(consumptionForecast));
 }
 
 void displayMenu() {
@@ -340,6 +571,21 @@ Medication createMedication() {
         while(getchar() != '\n');
     }
     
+    printf("Doses per day (0 if only taken as needed): ");
+    while(scanf("%d", &med.schedule.dosesPerDay) != 1 || med.schedule.dosesPerDay < 0) {
+        printf("Invalid input! Please enter a valid number of doses per day: ");
+        while(getchar() != '\n');
+    }
+    
+    med.schedule.tabletsPerDose = 0;
+    if (med.schedule.dosesPerDay > 0) {
+        printf("Tablets/capsules per dose: ");
+        while(scanf("%f", &med.schedule.tabletsPerDose) != 1 || med.schedule.tabletsPerDose <= 0) {
+            printf("Invalid input! Please enter a valid number of tablets per dose: ");
+            while(getchar() != '\n');
+        }
+    }
+    
     printf("Price per bottle/pack: $");
     while(scanf("%f", &med.price) != 1) {
         printf("Invalid input! Please enter a valid price: $");
@@ -352,6 +598,12 @@ Medication createMedication() {
         while(getchar() != '\n');
     }
     
+    printf("Tablets/capsules supplied per refill: ");
+    while(scanf("%d", &med.refill.tabletsPerRefill) != 1 || med.refill.tabletsPerRefill < 0) {
+        printf("Invalid input! Please enter a valid number of tablets: ");
+        while(getchar() != '\n');
+    }
+    
     printf("Next Refill Date when you need to refill (DD/MM/YYYY): ");
     scanf(" %[^\n]", med.refill.nextRefillDate);
     
@@ -366,23 +618,50 @@ void displayMedication(Medication med) {
     printf("Tablets Available: %d | Price per pack: $%.2f\n", med.quantity, med.price);             // Access and display structure elements (9 + 10) 
     printf("Prescription Refills Left: %d | Next Refill Due: %s\n", 
            med.refill.refillsRemaining, med.refill.nextRefillDate);                                 // Access and display structure elements (11 + 12) 
+    if (med.schedule.dosesPerDay > 0) {
+        printf("Dosing: %d dose(s) per day x %.1f tablet(s) | Tablets per Refill: %d\n",
+               med.schedule.dosesPerDay, med.schedule.tabletsPerDose, med.refill.tabletsPerRefill);
+    } else {
+        printf("Dosing: as needed | Tablets per Refill: %d\n", med.refill.tabletsPerRefill);
+    }
     printf("---------------------------\n");
 }
 
-void insertMedication(Medication med) {
+MedicationHandle insertMedication(Medication med) {
+    MedicationHandle handle = storeMedication(med);
+    if (handle.generation == 0) {
+        printf("Memory allocation failed!\n");
+    } else {
+        printf("Medication '%s' added successfully!\n", med.name);
+    }
+    return handle; // Handle the stack and queue use to refer to this medication
+}
+
+MedicationHandle storeMedication(Medication med) {
 
     // Implements insertion into a linked list through the function 
+    MedicationHandle invalid = {0, 0};
     MedicationNode* newNode = (MedicationNode*)malloc(sizeof(MedicationNode)); // Structure creation 
     if (newNode == NULL) {
-        printf("Memory allocation failed!\n");
-        return;
+        return invalid;
     }
 
     newNode->med = med;             // Assign entire structure to element
+    newNode->handle = allocateHandle(newNode);
+    if (newNode->handle.generation == 0) {
+        free(newNode);
+        return invalid;
+    }
+    if (!indexMedicationId(med.medicationId, newNode->handle)) {
+        releaseHandle(newNode->handle);
+        free(newNode);
+        return invalid;
+    }
     newNode->next = medicationList;  
     medicationList = newNode;
     
-    printf("Medication '%s' added successfully!\n", med.name);
+    addToFuzzyIndex(newNode);
+    return newNode->handle;
 }
 
 void deleteMedication(int medicationId) {
@@ -403,30 +682,40 @@ void deleteMedication(int medicationId) {
     }
     printf("\n");
     
-    MedicationNode* current = medicationList;
-    MedicationNode* previous = NULL;
-    
-    if (current->med.medicationId == medicationId) {
-        medicationList = current->next;
-        printf("Medication '%s' deleted successfully!\n", current->med.name);
-        free(current);
+    MedicationNode* current = unlinkMedication(medicationId);
+    if (current == NULL) {
+        printf("Medication with ID %d not found!\n", medicationId);
         return;
     }
+    
+    printf("Medication '%s' deleted successfully!\n", current->med.name);
+    releaseHandle(current->handle); // Invalidates any alerts or history entries for it
+    free(current);
+}
+
+MedicationNode* unlinkMedication(int medicationId) {
+    MedicationNode* current = medicationList;
+    MedicationNode* previous = NULL;
 
-    // Search for the medication to delete
+    // Search for the medication to detach
     while (current != NULL && current->med.medicationId != medicationId) { // Access nested structure element (14)  
         previous = current;
         current = current->next;
     }
-    
+
     if (current == NULL) {
-        printf("Medication with ID %d not found!\n", medicationId);
-        return;
+        return NULL;
     }
-    
-    previous->next = current->next;
-    printf("Medication '%s' deleted successfully!\n", current->med.name);
-    free(current);
+
+    if (previous == NULL) {
+        medicationList = current->next;
+    } else {
+        previous->next = current->next;
+    }
+    current->next = NULL;
+    unindexMedicationId(medicationId);
+    removeFromFuzzyIndex();
+    return current;
 }
 
 void updateMedication(int medicationId) {
@@ -449,7 +738,18 @@ void updateMedication(int medicationId) {
             // Check if the new ID is either the same as original or is unique
             if (updatedMed.medicationId == originalId || !isDuplicateId(updatedMed.medicationId)) {
                 // If valid, update the entire medication
+                int renamed = strcmp(current->med.name, updatedMed.name) != 0;
+                if (updatedMed.medicationId != originalId) {
+                    if (!indexMedicationId(updatedMed.medicationId, current->handle)) {
+                        printf("Update failed: Memory allocation failed!\n");
+                        return;
+                    }
+                    unindexMedicationId(originalId);
+                }
                 current->med = updatedMed;
+                if (renamed) {
+                    renameInFuzzyIndex(current); // The name index still holds the old name
+                }
                 printf("Medication updated successfully!\n");
             } else {
                 // If duplicate ID (not the original), show error
@@ -482,24 +782,178 @@ void displayMedicationList() {
     }
 }
 
-void pushMedication(Medication med) {
+// Hands out a slot in the handle table for a newly inserted node
+MedicationHandle allocateHandle(MedicationNode* node) {
+    MedicationHandle handle = {0, 0};
+    unsigned int index;
+
+    if (medicationStore.freeHead != NO_FREE_SLOT) {
+        // Reuse a released slot; its generation was already bumped on release
+        index = medicationStore.freeHead;
+        medicationStore.freeHead = medicationStore.slots[index].nextFree;
+    } else {
+        if (medicationStore.used == medicationStore.capacity) {
+            unsigned int newCapacity = medicationStore.capacity == 0 ? INITIAL_SLOT_CAPACITY : medicationStore.capacity * 2;
+            MedicationSlot* grown = (MedicationSlot*)realloc(medicationStore.slots, newCapacity * sizeof(MedicationSlot));
+            if (grown == NULL) {
+                return handle; // Generation 0 marks an invalid handle
+            }
+            medicationStore.slots = grown;
+            medicationStore.capacity = newCapacity;
+        }
+        index = medicationStore.used++;
+        medicationStore.slots[index].generation = 1; // Generation 0 is never valid
+    }
+
+    medicationStore.slots[index].node = node;
+    medicationStore.slots[index].nextFree = NO_FREE_SLOT;
+    handle.index = index;
+    handle.generation = medicationStore.slots[index].generation;
+    return handle;
+}
+
+// Returns the slot to the free list and makes every outstanding handle to it stale
+void releaseHandle(MedicationHandle handle) {
+    if (resolveHandle(handle) == NULL) {
+        return;
+    }
+
+    MedicationSlot* slot = &medicationStore.slots[handle.index];
+    slot->node = NULL;
+    slot->generation++;
+    if (slot->generation == 0) {
+        slot->generation = 1; // Skip the invalid generation on wrap-around
+    }
+    slot->nextFree = medicationStore.freeHead;
+    medicationStore.freeHead = handle.index;
+}
+
+// Returns the live medication for a handle, or NULL if it has been deleted
+Medication* resolveHandle(MedicationHandle handle) {
+    if (handle.generation == 0 || handle.index >= medicationStore.used) {
+        return NULL;
+    }
+
+    MedicationSlot* slot = &medicationStore.slots[handle.index];
+    if (slot->generation != handle.generation || slot->node == NULL) {
+        return NULL;
+    }
+    return &slot->node->med;
+}
+
+unsigned int hashMedicationId(int medicationId, unsigned int capacity) {
+    unsigned int hash = (unsigned int)medicationId * 2654435761u; // Knuth multiplicative hash
+    return (hash ^ (hash >> 16)) & (capacity - 1);
+}
+
+// Rebuilds the ID table at newCapacity, dropping tombstones
+int resizeIdIndex(unsigned int newCapacity) {
+    MedicationIdEntry* entries = (MedicationIdEntry*)calloc(newCapacity, sizeof(MedicationIdEntry));
+    if (entries == NULL) {
+        return 0;
+    }
+
+    for (unsigned int i = 0; i < medicationIdIndex.capacity; i++) {
+        MedicationIdEntry* old = &medicationIdIndex.entries[i];
+        if (old->state == ID_ENTRY_USED) {
+            unsigned int slot = hashMedicationId(old->medicationId, newCapacity);
+            while (entries[slot].state != ID_ENTRY_EMPTY) {
+                slot = (slot + 1) & (newCapacity - 1);
+            }
+            entries[slot] = *old;
+        }
+    }
+
+    free(medicationIdIndex.entries);
+    medicationIdIndex.entries = entries;
+    medicationIdIndex.capacity = newCapacity;
+    medicationIdIndex.deleted = 0;
+    return 1;
+}
+
+// Returns the slot holding medicationId, or -1 if it is not indexed
+long findIdEntry(int medicationId) {
+    if (medicationIdIndex.capacity == 0) {
+        return -1;
+    }
+
+    unsigned int slot = hashMedicationId(medicationId, medicationIdIndex.capacity);
+    while (medicationIdIndex.entries[slot].state != ID_ENTRY_EMPTY) {
+        MedicationIdEntry* entry = &medicationIdIndex.entries[slot];
+        if (entry->state == ID_ENTRY_USED && entry->medicationId == medicationId) {
+            return (long)slot;
+        }
+        slot = (slot + 1) & (medicationIdIndex.capacity - 1);
+    }
+    return -1;
+}
+
+// Maps medicationId to handle (replacing any existing mapping); returns 0 if memory runs out
+int indexMedicationId(int medicationId, MedicationHandle handle) {
+    long existing = findIdEntry(medicationId);
+    if (existing >= 0) {
+        medicationIdIndex.entries[existing].handle = handle;
+        return 1;
+    }
+
+    // Keep the table at most 3/4 full, counting tombstones since they lengthen probes
+    if ((medicationIdIndex.count + medicationIdIndex.deleted + 1) * 4 > medicationIdIndex.capacity * 3) {
+        unsigned int newCapacity = medicationIdIndex.capacity == 0 ? INITIAL_SLOT_CAPACITY : medicationIdIndex.capacity;
+        while ((medicationIdIndex.count + 1) * 2 > newCapacity) {
+            newCapacity *= 2;
+        }
+        if (!resizeIdIndex(newCapacity)) {
+            return 0;
+        }
+    }
+
+    unsigned int slot = hashMedicationId(medicationId, medicationIdIndex.capacity);
+    while (medicationIdIndex.entries[slot].state == ID_ENTRY_USED) {
+        slot = (slot + 1) & (medicationIdIndex.capacity - 1);
+    }
+    if (medicationIdIndex.entries[slot].state == ID_ENTRY_DELETED) {
+        medicationIdIndex.deleted--;
+    }
+    medicationIdIndex.entries[slot].medicationId = medicationId;
+    medicationIdIndex.entries[slot].state = ID_ENTRY_USED;
+    medicationIdIndex.entries[slot].handle = handle;
+    medicationIdIndex.count++;
+    return 1;
+}
+
+void unindexMedicationId(int medicationId) {
+    long slot = findIdEntry(medicationId);
+    if (slot >= 0) {
+        medicationIdIndex.entries[slot].state = ID_ENTRY_DELETED;
+        medicationIdIndex.count--;
+        medicationIdIndex.deleted++;
+    }
+}
+
+// Returns the live medication with this ID, or NULL if there is none
+Medication* findMedicationById(int medicationId) {
+    long slot = findIdEntry(medicationId);
+    return slot >= 0 ? resolveHandle(medicationIdIndex.entries[slot].handle) : NULL;
+}
+
+void pushMedication(MedicationHandle handle) {
     if (medicationHistory.top >= STACK_SIZE - 1) { // Access structure element (16) 
         printf("Medication history is full!\n");
         return;
     }
     
-    medicationHistory.items[++medicationHistory.top] = med; // Access array in structure and assign (17) 
+    medicationHistory.items[++medicationHistory.top] = handle; // Access array in structure and assign (17) 
 }
 
-Medication popMedication() {
-    // Function body that removes and returns a medication from the stack 
+MedicationHandle popMedication() {
+    // Function body that removes and returns a medication handle from the stack 
     if (isStackEmpty()) {
         printf("No medication history available!\n");
-        Medication empty = {0};
+        MedicationHandle empty = {0, 0};
         return empty;
     }
 
-    return medicationHistory.items[medicationHistory.top--]; // This function returns a Medication structure from the top of the stack + Access array in structure (18) 
+    return medicationHistory.items[medicationHistory.top--]; // This function returns a handle from the top of the stack + Access array in structure (18) 
 }
 
 void displayMedicationHistory() {
@@ -511,7 +965,12 @@ void displayMedicationHistory() {
     printf("\n=== MEDICATION HISTORY (Most Recent First) ===\n");
     for (int i = medicationHistory.top; i >= 0; i--) {
         printf("\n--- History Entry %d ---", medicationHistory.top - i + 1);
-        displayMedication(medicationHistory.items[i]);
+        Medication* med = resolveHandle(medicationHistory.items[i]); // Always shows the current details
+        if (med != NULL) {
+            displayMedication(*med);
+        } else {
+            printf("\n(Medication has been deleted)\n");
+        }
     }
 }
 
@@ -519,32 +978,37 @@ int isStackEmpty() {
     return medicationHistory.top == -1;
 }
 
-void enqueueMedication(Medication med) {
+void enqueueMedication(MedicationHandle handle) {
+    Medication* med = resolveHandle(handle);
+    if (med == NULL) {
+        printf("Cannot queue a refill alert for a deleted medication!\n");
+        return;
+    }
     if (isQueueFull()) {
         printf("Refill alert queue is full!\n");
         return;
     }
     
     refillAlerts.rear = (refillAlerts.rear + 1) % QUEUE_SIZE; // Access and modify structure element (19) 
-    refillAlerts.items[refillAlerts.rear] = med;             // Access array in structure and assign (20) 
+    refillAlerts.items[refillAlerts.rear] = handle;          // Access array in structure and assign (20) 
     refillAlerts.count++;                                   // Access and modify structure element (21) 
     
-    printf("Refill alert queued for '%s'\n", med.name);
+    printf("Refill alert queued for '%s'\n", med->name);
 }
 
-Medication dequeueMedication() {
-    // Function body that removes and returns a medication from the queue 
+MedicationHandle dequeueMedication() {
+    // Function body that removes and returns a medication handle from the queue 
     if (isQueueEmpty()) {
         printf("No refill alerts in queue!\n");
-        Medication empty = {0};
+        MedicationHandle empty = {0, 0};
         return empty;
     }
     
-    Medication med = refillAlerts.items[refillAlerts.front];        // Access array in structure (22)
-    refillAlerts.front = (refillAlerts.front + 1) % QUEUE_SIZE;    // Access and modify structure element (23)
-    refillAlerts.count--;                                         // Access and modify structure element (24) 
+    MedicationHandle handle = refillAlerts.items[refillAlerts.front]; // Access array in structure (22)
+    refillAlerts.front = (refillAlerts.front + 1) % QUEUE_SIZE;      // Access and modify structure element (23)
+    refillAlerts.count--;                                           // Access and modify structure element (24) 
     
-    return med; // This function returns a Medication structure from the front of the queue  
+    return handle; // This function returns the handle at the front of the queue  
 }
 
 void displayRefillAlerts() {
@@ -557,7 +1021,12 @@ void displayRefillAlerts() {
     int index = refillAlerts.front;
     for (int i = 0; i < refillAlerts.count; i++) {
         printf("\n--- Alert %d ---", i + 1);
-        displayMedication(refillAlerts.items[index]);
+        Medication* med = resolveHandle(refillAlerts.items[index]); // Live quantity and refill date
+        if (med != NULL) {
+            displayMedication(*med);
+        } else {
+            printf("\n(Medication has been deleted - alert no longer applies)\n");
+        }
         index = (index + 1) % QUEUE_SIZE;
     }
 }
@@ -566,17 +1035,312 @@ int isQueueEmpty() {
     return refillAlerts.count == 0;
 }
 
+// Alerts for deleted medications are only dropped when their slots are needed
 int isQueueFull() {
-    return refillAlerts.count == QUEUE_SIZE;
+    return refillAlerts.count == QUEUE_SIZE && dropStaleAlerts() == QUEUE_SIZE;
+}
+
+// Compacts the queue in order, dropping alerts whose medication has been deleted;
+// returns the number of alerts left
+int dropStaleAlerts() {
+    int kept = 0;
+    int index = refillAlerts.front;
+    for (int i = 0; i < refillAlerts.count; i++) {
+        MedicationHandle handle = refillAlerts.items[index];
+        if (resolveHandle(handle) != NULL) {
+            refillAlerts.items[(refillAlerts.front + kept) % QUEUE_SIZE] = handle;
+            kept++;
+        }
+        index = (index + 1) % QUEUE_SIZE;
+    }
+    refillAlerts.count = kept;
+    refillAlerts.rear = (refillAlerts.front + kept - 1 + QUEUE_SIZE) % QUEUE_SIZE;
+    return kept;
+}
+
+int isAlertQueued(MedicationHandle handle) {
+    int index = refillAlerts.front;
+    for (int i = 0; i < refillAlerts.count; i++) {
+        MedicationHandle queued = refillAlerts.items[index];
+        if (queued.index == handle.index && queued.generation == handle.generation) {
+            return 1;
+        }
+        index = (index + 1) % QUEUE_SIZE;
+    }
+    return 0;
+}
+
+// Copies the inputs of every medication into the forecast's contiguous arrays,
+// growing them when the inventory has grown; returns 0 if memory runs out
+int gatherForecastInputs(ConsumptionForecast* forecast) {
+    int count = getMedicationCount();
+
+    if (count > forecast->capacity) {
+        int newCapacity = forecast->capacity == 0 ? INITIAL_SLOT_CAPACITY : forecast->capacity;
+        while (newCapacity < count) {
+            newCapacity *= 2;
+        }
+        MedicationHandle* handles = (MedicationHandle*)realloc(forecast->handles, newCapacity * sizeof(MedicationHandle));
+        if (handles != NULL) forecast->handles = handles;
+        float* quantity = (float*)realloc(forecast->quantity, newCapacity * sizeof(float));
+        if (quantity != NULL) forecast->quantity = quantity;
+        float* dailyUse = (float*)realloc(forecast->dailyUse, newCapacity * sizeof(float));
+        if (dailyUse != NULL) forecast->dailyUse = dailyUse;
+        float* refillSupply = (float*)realloc(forecast->refillSupply, newCapacity * sizeof(float));
+        if (refillSupply != NULL) forecast->refillSupply = refillSupply;
+        int* runOutDay = (int*)realloc(forecast->runOutDay, newCapacity * sizeof(int));
+        if (runOutDay != NULL) forecast->runOutDay = runOutDay;
+        int* exhaustionDay = (int*)realloc(forecast->exhaustionDay, newCapacity * sizeof(int));
+        if (exhaustionDay != NULL) forecast->exhaustionDay = exhaustionDay;
+
+        if (handles == NULL || quantity == NULL || dailyUse == NULL || refillSupply == NULL ||
+            runOutDay == NULL || exhaustionDay == NULL) {
+            return 0; // Arrays that did grow are kept; capacity still reflects the smallest
+        }
+        forecast->capacity = newCapacity;
+    }
+
+    int i = 0;
+    for (MedicationNode* current = medicationList; current != NULL; current = current->next, i++) {
+        const Medication* med = &current->med;
+        forecast->handles[i] = current->handle;
+        forecast->quantity[i] = (float)med->quantity;
+        forecast->dailyUse[i] = med->schedule.dosesPerDay * med->schedule.tabletsPerDose;
+        forecast->refillSupply[i] = (float)med->refill.refillsRemaining * med->refill.tabletsPerRefill;
+    }
+    forecast->count = count;
+    return 1;
+}
+
+// Projects run-out and refill-exhaustion days for n medications in a single pass.
+// The loop body has no branches or calls (the selects compile to blends), so the
+// compiler can vectorize it across the contiguous input arrays.
+void projectConsumption(int n, const float* RESTRICT quantity, const float* RESTRICT dailyUse,
+                        const float* RESTRICT refillSupply, int* RESTRICT runOutDay, int* RESTRICT exhaustionDay) {
+    for (int i = 0; i < n; i++) {
+        float rate = dailyUse[i];
+        float safeRate = rate > 0.0f ? rate : 1.0f; // Keeps unscheduled lanes free of division by zero
+        float onHand = quantity[i] > 0.0f ? quantity[i] : 0.0f;
+        float withRefills = onHand + (refillSupply[i] > 0.0f ? refillSupply[i] : 0.0f);
+
+        float runOut = onHand / safeRate;
+        float exhausted = withRefills / safeRate;
+        runOut = runOut < MAX_FORECAST_DAYS ? runOut : MAX_FORECAST_DAYS;
+        exhausted = exhausted < MAX_FORECAST_DAYS ? exhausted : MAX_FORECAST_DAYS;
+
+        runOutDay[i] = rate > 0.0f ? (int)runOut : NO_FORECAST;
+        exhaustionDay[i] = rate > 0.0f ? (int)exhausted : NO_FORECAST;
+    }
+}
+
+// Finds the maxRows scheduled medications with the soonest days (run-out or exhaustion) in
+// one pass, keeping them in a small sorted array; also counts how many fall within window
+int selectSoonestDays(const ConsumptionForecast* forecast, const int* days, int window, int rows[], int maxRows, int* dueCount) {
+    int selected = 0;
+    *dueCount = 0;
+
+    for (int i = 0; i < forecast->count; i++) {
+        int day = days[i];
+        if (day == NO_FORECAST) {
+            continue;
+        }
+        if (day <= window) {
+            (*dueCount)++;
+        }
+        if (selected == maxRows && day >= days[rows[selected - 1]]) {
+            continue; // Not sooner than anything already selected
+        }
+
+        int j = selected < maxRows ? selected++ : maxRows - 1;
+        while (j > 0 && days[rows[j - 1]] > day) {
+            rows[j] = rows[j - 1];
+            j--;
+        }
+        rows[j] = i;
+    }
+    return selected;
+}
+
+// Days since 01/01/1970 for a calendar date (proleptic Gregorian calendar)
+int daysFromCivil(int year, int month, int day) {
+    year -= month <= 2;
+    int era = (year >= 0 ? year : year - 399) / 400;
+    int yearOfEra = year - era * 400;
+    int dayOfYear = (153 * (month + (month > 2 ? -3 : 9)) + 2) / 5 + day - 1;
+    int dayOfEra = yearOfEra * 365 + yearOfEra / 4 - yearOfEra / 100 + dayOfYear;
+    return era * 146097 + dayOfEra - 719468;
+}
+
+// Inverse of daysFromCivil
+void civilFromDays(int days, int* year, int* month, int* day) {
+    days += 719468;
+    int era = (days >= 0 ? days : days - 146096) / 146097;
+    int dayOfEra = days - era * 146097;
+    int yearOfEra = (dayOfEra - dayOfEra / 1460 + dayOfEra / 36524 - dayOfEra / 146096) / 365;
+    int dayOfYear = dayOfEra - (365 * yearOfEra + yearOfEra / 4 - yearOfEra / 100);
+    int monthIndex = (5 * dayOfYear + 2) / 153;
+    *day = dayOfYear - (153 * monthIndex + 2) / 5 + 1;
+    *month = monthIndex + (monthIndex < 10 ? 3 : -9);
+    *year = yearOfEra + era * 400 + (*month <= 2);
+}
+
+int currentDayNumber() {
+    time_t now = time(NULL);
+    struct tm* local = localtime(&now);
+    return daysFromCivil(local->tm_year + 1900, local->tm_mon + 1, local->tm_mday);
+}
+
+// Writes today + daysFromToday as DD/MM/YYYY, matching the refill date format
+void formatForecastDate(int today, int daysFromToday, char* buffer, size_t size) {
+    if (daysFromToday == NO_FORECAST) {
+        snprintf(buffer, size, "No schedule");
+        return;
+    }
+    if (daysFromToday >= MAX_FORECAST_DAYS) {
+        snprintf(buffer, size, "100+ years");
+        return;
+    }
+
+    int year, month, day;
+    civilFromDays(today + daysFromToday, &year, &month, &day);
+    snprintf(buffer, size, "%02d/%02d/%04d", day, month, year);
+}
+
+// Queues a refill alert from the forecast unless the queue is full or it is already queued
+int queueForecastAlert(MedicationHandle handle) {
+    if (isQueueFull() || isAlertQueued(handle)) {
+        return 0;
+    }
+    enqueueMedication(handle);
+    return 1;
+}
+
+// Recomputes the forecast for the whole inventory, lists the soonest run-outs and the
+// medications whose refills are used up soon, and queues refill alerts for run-outs within
+// FORECAST_ALERT_DAYS and for refills used up within FORECAST_PRESCRIPTION_DAYS, soonest first
+void forecastRefillAlerts() {
+    ConsumptionForecast* forecast = &consumptionForecast;
+    if (!gatherForecastInputs(forecast)) {
+        printf("Memory allocation failed!\n");
+        return;
+    }
+    projectConsumption(forecast->count, forecast->quantity, forecast->dailyUse,
+                       forecast->refillSupply, forecast->runOutDay, forecast->exhaustionDay);
+    forecast->today = currentDayNumber();
+
+    int rows[FORECAST_REPORT_ROWS];
+    int dueCount;
+    int selected = selectSoonestDays(forecast, forecast->runOutDay, FORECAST_ALERT_DAYS, rows,
+                                     FORECAST_REPORT_ROWS, &dueCount);
+    int prescriptionRows[FORECAST_REPORT_ROWS];
+    int prescriptionCount;
+    int prescriptionSelected = selectSoonestDays(forecast, forecast->exhaustionDay, FORECAST_PRESCRIPTION_DAYS,
+                                                 prescriptionRows, FORECAST_REPORT_ROWS, &prescriptionCount);
+
+    printf("\n=== CONSUMPTION FORECAST ===\n");
+    printf("%d medication(s) forecast, %d run out within %d days, %d use up their refills within %d days.\n",
+           forecast->count, dueCount, FORECAST_ALERT_DAYS, prescriptionCount, FORECAST_PRESCRIPTION_DAYS);
+    if (selected > 0) {
+        printf("Soonest run-outs:\n");
+    }
+
+    int queued = 0;
+    for (int r = 0; r < selected; r++) {
+        int i = rows[r];
+        Medication* med = resolveHandle(forecast->handles[i]);
+        char runOutDate[16];
+        char exhaustionDate[16];
+        formatForecastDate(forecast->today, forecast->runOutDay[i], runOutDate, sizeof(runOutDate));
+        formatForecastDate(forecast->today, forecast->exhaustionDay[i], exhaustionDate, sizeof(exhaustionDate));
+        printf("ID: %d - %s | Uses %.1f/day | Runs out: %s | Refills used up: %s\n",
+               med->medicationId, med->name, forecast->dailyUse[i], runOutDate, exhaustionDate);
+
+        if (forecast->runOutDay[i] <= FORECAST_ALERT_DAYS) {
+            queued += queueForecastAlert(forecast->handles[i]);
+        }
+    }
+
+    if (prescriptionCount > 0) {
+        printf("New prescription needed (refills used up within %d days):\n", FORECAST_PRESCRIPTION_DAYS);
+    }
+    for (int r = 0; r < prescriptionSelected && forecast->exhaustionDay[prescriptionRows[r]] <= FORECAST_PRESCRIPTION_DAYS; r++) {
+        int i = prescriptionRows[r];
+        Medication* med = resolveHandle(forecast->handles[i]);
+        char exhaustionDate[16];
+        formatForecastDate(forecast->today, forecast->exhaustionDay[i], exhaustionDate, sizeof(exhaustionDate));
+        printf("ID: %d - %s | Refills left: %d | Refills used up: %s\n",
+               med->medicationId, med->name, med->refill.refillsRemaining, exhaustionDate);
+        queued += queueForecastAlert(forecast->handles[i]);
+    }
+
+    if (queued == 0) {
+        printf("\nNo new refill alerts: nothing else runs out within %d days or needs a new prescription within %d days.\n",
+               FORECAST_ALERT_DAYS, FORECAST_PRESCRIPTION_DAYS);
+    } else {
+        printf("\n%d refill alert(s) queued from the forecast.\n", queued);
+    }
+}
+
+// Fills the store with n synthetic medications and times one full nightly run of
+// forecastRefillAlerts: gather from the list, project, select and queue alerts
+void runForecastBenchmark(int n) {
+    if (n < 1) {
+        printf("Benchmark needs at least 1 medication!\n");
+        return;
+    }
+
+    initializeSystem();
+    srand(42);
+    for (int i = 0; i < n; i++) {
+        Medication med;
+        memset(&med, 0, sizeof(med));
+        med.medicationId = i + 1;
+        snprintf(med.name, sizeof(med.name), "Medication%d", i + 1);
+        strcpy(med.dosage, "10mg");
+        med.quantity = rand() % 200;
+        med.refill.refillsRemaining = rand() % 6;
+        med.refill.tabletsPerRefill = 30;
+        strcpy(med.refill.nextRefillDate, "01/01/2030");
+        if (rand() % 10 != 0) { // Some as-needed medications without a schedule
+            med.schedule.dosesPerDay = 1 + rand() % 3;
+            med.schedule.tabletsPerDose = (float)(1 + rand() % 2);
+        }
+        if (storeMedication(med).generation == 0) {
+            printf("Memory allocation failed after %d medications!\n", i);
+            cleanupSystem();
+            return;
+        }
+    }
+
+    clock_t start = clock();
+    forecastRefillAlerts();
+    double seconds = (double)(clock() - start) / CLOCKS_PER_SEC;
+
+    printf("\n=== FORECAST BENCHMARK (%d medications) ===\n", n);
+    printf("Nightly forecast run: %.1f ms (%.1f ns per medication)\n", seconds * 1e3, seconds * 1e9 / n);
+    cleanupSystem();
 }
 
 void searchMedication() { // Implements linear sequential search method through the function 
     printf("\n=== MEDICATION SEARCH ===\n");
+    printf("1. Exact / Partial Name Match\n2. Typo-Tolerant Match (1 typo)\n");
+    printf("3. Typo-Tolerant Match (2 typos, slower on large inventories)\n");
+    printf("Enter choice (1-3): ");
+    
+    int searchChoice;
+    scanf("%d", &searchChoice);
+    
     printf("Enter medication name to search: ");
-    char searchName[50];
-    scanf(" %[^\n]", searchName);
+    char searchName[NAME_SIZE];
+    scanf(" %49[^\n]", searchName);
     
-    linearSearch(searchName);
+    if (searchChoice == 2 || searchChoice == 3) {
+        // 1 typo keeps a search under a millisecond at 100K names; 2 typos visits far
+        // more of the BK-tree (a few milliseconds at that size), so it is opt-in
+        fuzzySearch(searchName, searchChoice == 2 ? 1 : 2);
+    } else {
+        linearSearch(searchName);
+    }
 }
 
 void linearSearch(char* searchName) {
@@ -599,22 +1363,326 @@ void linearSearch(char* searchName) {
     }
 }
 
-void sortMedications() {
-    int count = getMedicationCount();
-    if (count == 0) {
-        printf("No medications to sort!\n");
-        return;
+// Levenshtein distance between the pattern encoded in peq and text, computed a whole
+// column at a time with Myers' bit-vector algorithm (pattern length must be <= 64)
+int editDistance(const uint64_t peq[256], int patternLength, const char* text) {
+    if (patternLength == 0) {
+        return (int)strlen(text);
     }
-    
-    Medication* medArray = (Medication*)malloc(count * sizeof(Medication)); // Create an array of Medication structures (26)
 
-    // Populate the array from the linked list
-    MedicationNode* current = medicationList;
-    int i = 0;
-    
-    while (current != NULL) {
-        medArray[i++] = current->med; // Assign structure to array element (27) 
-        current = current->next;
+    uint64_t pv = ~(uint64_t)0; // Vertical +1 deltas
+    uint64_t mv = 0;            // Vertical -1 deltas
+    uint64_t last = (uint64_t)1 << (patternLength - 1);
+    int score = patternLength;
+
+    for (; *text != '\0'; text++) {
+        uint64_t eq = peq[(unsigned char)*text];
+        uint64_t xv = eq | mv;
+        uint64_t xh = (((eq & pv) + pv) ^ pv) | eq;
+        uint64_t ph = mv | ~(xh | pv);
+        uint64_t mh = pv & xh;
+
+        if (ph & last) {
+            score++;
+        } else if (mh & last) {
+            score--;
+        }
+
+        ph = (ph << 1) | 1; // Row 0 grows by one per text character (global distance)
+        mh <<= 1;
+        pv = mh | ~(xv | ph);
+        mv = ph & xv;
+    }
+
+    return score;
+}
+
+void lowercaseName(char* dest, const char* src) {
+    int i = 0;
+    for (; src[i] != '\0' && i < NAME_SIZE - 1; i++) {
+        dest[i] = (char)tolower((unsigned char)src[i]);
+    }
+    dest[i] = '\0';
+}
+
+void buildPatternMasks(uint64_t peq[256], const char* pattern, int length) {
+    memset(peq, 0, 256 * sizeof(uint64_t));
+    for (int i = 0; i < length; i++) {
+        peq[(unsigned char)pattern[i]] |= (uint64_t)1 << i;
+    }
+}
+
+// Appends a medication name to the index. Only the key is stored here: searches scan it as
+// part of the unpacked tail, and it is linked into the BK-tree (linkFuzzyNode) when the tail
+// is next repacked, so inserting medications (e.g. server ADD requests) stays cheap
+void addToFuzzyIndex(MedicationNode* node) {
+    if (fuzzyIndex.dirty) {
+        return; // The next search rebuilds the whole tree anyway
+    }
+
+    if (fuzzyIndex.count == fuzzyIndex.capacity) {
+        int newCapacity = fuzzyIndex.capacity == 0 ? INITIAL_SLOT_CAPACITY : fuzzyIndex.capacity * 2;
+        FuzzyNode* grown = (FuzzyNode*)realloc(fuzzyIndex.nodes, newCapacity * sizeof(FuzzyNode));
+        if (grown == NULL) {
+            fuzzyIndex.dirty = 1; // Retry from scratch on the next search
+            return;
+        }
+        fuzzyIndex.nodes = grown;
+        fuzzyIndex.capacity = newCapacity;
+    }
+
+    int index = fuzzyIndex.count++;
+    FuzzyNode* entry = &fuzzyIndex.nodes[index];
+    entry->handle = node->handle;
+    lowercaseName(entry->key, node->med.name);
+    entry->keyLength = (int)strlen(entry->key);
+    entry->distance = 0;
+    entry->firstChild = -1;
+    entry->nextSibling = -1;
+}
+
+// Inserts node index into the BK-tree: walk down the child whose edge distance
+// matches, and hang the node there when no such child exists
+void linkFuzzyNode(int index) {
+    FuzzyNode* entry = &fuzzyIndex.nodes[index];
+    if (index == 0) {
+        return; // First node becomes the root
+    }
+
+    uint64_t peq[256];
+    buildPatternMasks(peq, entry->key, entry->keyLength);
+
+    int parent = 0;
+    for (;;) {
+        int distance = editDistance(peq, entry->keyLength, fuzzyIndex.nodes[parent].key);
+        int child = fuzzyIndex.nodes[parent].firstChild;
+        while (child != -1 && fuzzyIndex.nodes[child].distance != distance) {
+            child = fuzzyIndex.nodes[child].nextSibling;
+        }
+        if (child == -1) {
+            entry->distance = distance;
+            entry->nextSibling = fuzzyIndex.nodes[parent].firstChild;
+            fuzzyIndex.nodes[parent].firstChild = index;
+            return;
+        }
+        parent = child;
+    }
+}
+
+// Called when a medication leaves the list. Its entry stays in the tree (searches skip it
+// through its handle) until stale entries pass a quarter of the tree, then it is rebuilt
+void removeFromFuzzyIndex() {
+    fuzzyIndex.staleCount++;
+    if (fuzzyIndex.staleCount * 4 > fuzzyIndex.count) {
+        fuzzyIndex.dirty = 1;
+    }
+}
+
+// Called after a medication is renamed. Its old entry is retired in both the build tree and
+// the packed copy (it keeps routing but can no longer match) and the new name is appended
+void renameInFuzzyIndex(MedicationNode* node) {
+    MedicationHandle retired = {0, 0}; // Generation 0 never resolves
+    for (int i = 0; i < fuzzyIndex.count; i++) {
+        if (fuzzyIndex.nodes[i].handle.index == node->handle.index &&
+            fuzzyIndex.nodes[i].handle.generation == node->handle.generation) {
+            fuzzyIndex.nodes[i].handle = retired;
+        }
+    }
+    for (int i = 0; i < fuzzyIndex.packedCount; i++) {
+        if (fuzzyIndex.packed[i].handle.index == node->handle.index &&
+            fuzzyIndex.packed[i].handle.generation == node->handle.generation) {
+            fuzzyIndex.packed[i].handle = retired;
+        }
+    }
+    removeFromFuzzyIndex();
+    addToFuzzyIndex(node);
+}
+
+// Rebuilds the BK-tree from the linked list, dropping entries for deleted medications
+void rebuildFuzzyIndex() {
+    fuzzyIndex.count = 0;
+    fuzzyIndex.linkedCount = 0;
+    fuzzyIndex.staleCount = 0;
+    fuzzyIndex.packedCount = 0;
+    fuzzyIndex.dirty = 0;
+    for (MedicationNode* current = medicationList; current != NULL; current = current->next) {
+        addToFuzzyIndex(current);
+    }
+}
+
+// Links every queued name into the build tree, then copies it into breadth-first order so each node's children sit next to each
+// other and their edge distances can be scanned without touching the child nodes
+int packFuzzyIndex() {
+    if (fuzzyIndex.pendingCapacity < fuzzyIndex.count) {
+        int* grown = (int*)realloc(fuzzyIndex.pending, fuzzyIndex.count * sizeof(int));
+        if (grown == NULL) {
+            return 0;
+        }
+        fuzzyIndex.pending = grown;
+        fuzzyIndex.pendingCapacity = fuzzyIndex.count;
+    }
+    if (fuzzyIndex.packedCapacity < fuzzyIndex.count) {
+        FuzzyNode* grownNodes = (FuzzyNode*)realloc(fuzzyIndex.packed, fuzzyIndex.capacity * sizeof(FuzzyNode));
+        if (grownNodes == NULL) {
+            return 0;
+        }
+        fuzzyIndex.packed = grownNodes;
+        unsigned char* grownEdges = (unsigned char*)realloc(fuzzyIndex.packedEdges, fuzzyIndex.capacity);
+        if (grownEdges == NULL) {
+            return 0;
+        }
+        fuzzyIndex.packedEdges = grownEdges;
+        fuzzyIndex.packedCapacity = fuzzyIndex.capacity;
+    }
+
+    while (fuzzyIndex.linkedCount < fuzzyIndex.count) {
+        linkFuzzyNode(fuzzyIndex.linkedCount++);
+    }
+
+    // The pending list doubles as the BFS queue; a node's queue position is its packed index
+    int* queue = fuzzyIndex.pending;
+    int tail = 0;
+    queue[tail++] = 0;
+    for (int head = 0; head < tail; head++) {
+        FuzzyNode* source = &fuzzyIndex.nodes[queue[head]];
+        FuzzyNode* target = &fuzzyIndex.packed[head];
+        *target = *source;
+        target->firstChild = tail;
+        target->nextSibling = -1;
+        target->childCount = 0;
+        for (int child = source->firstChild; child != -1; child = fuzzyIndex.nodes[child].nextSibling) {
+            queue[tail++] = child;
+            target->childCount++;
+        }
+        fuzzyIndex.packedEdges[head] = (unsigned char)source->distance;
+    }
+
+    fuzzyIndex.packedCount = fuzzyIndex.count;
+    return 1;
+}
+
+// Adds one hit to a growing match list; returns 0 if memory runs out
+int appendFuzzyMatch(FuzzyMatch** matches, int* matchCount, int* matchCapacity, MedicationHandle handle, int distance) {
+    if (*matchCount == *matchCapacity) {
+        int newCapacity = *matchCapacity == 0 ? INITIAL_SLOT_CAPACITY : *matchCapacity * 2;
+        FuzzyMatch* grown = (FuzzyMatch*)realloc(*matches, newCapacity * sizeof(FuzzyMatch));
+        if (grown == NULL) {
+            return 0;
+        }
+        *matches = grown;
+        *matchCapacity = newCapacity;
+    }
+    (*matches)[*matchCount].handle = handle;
+    (*matches)[*matchCount].distance = distance;
+    (*matchCount)++;
+    return 1;
+}
+
+// Typo-tolerant search: walks the packed BK-tree, only descending into children whose edge
+// distance can still lead to a match (triangle inequality), then scans the names added since
+// the last repack, and ranks hits by distance
+void fuzzySearch(char* searchName, int maxDistance) {
+    printf("\n=== FUZZY SEARCH RESULTS (up to %d typo%s) ===\n", maxDistance, maxDistance == 1 ? "" : "s");
+
+    if (fuzzyIndex.dirty) {
+        rebuildFuzzyIndex();
+    }
+    if (fuzzyIndex.count == 0) {
+        printf("No medications found matching '%s'\n", searchName);
+        return;
+    }
+    // A short tail is cheaper to scan than to repack; repack once it passes a fraction of the tree
+    int tailCount = fuzzyIndex.count - fuzzyIndex.packedCount;
+    if ((fuzzyIndex.packedCount == 0 || tailCount > fuzzyIndex.count / FUZZY_TAIL_FRACTION) && !packFuzzyIndex()) {
+        printf("Memory allocation failed!\n");
+        return;
+    }
+
+    char pattern[NAME_SIZE];
+    uint64_t peq[256];
+    lowercaseName(pattern, searchName);
+    int patternLength = (int)strlen(pattern);
+    buildPatternMasks(peq, pattern, patternLength);
+
+    FuzzyMatch* matches = NULL;
+    int matchCount = 0;
+    int matchCapacity = 0;
+    int pendingCount = 0;
+    fuzzyIndex.pending[pendingCount++] = 0;
+
+    while (pendingCount > 0) {
+        FuzzyNode* node = &fuzzyIndex.packed[fuzzyIndex.pending[--pendingCount]];
+        int lengthGap = node->keyLength > patternLength ? node->keyLength - patternLength : patternLength - node->keyLength;
+        if (node->childCount == 0 && lengthGap > maxDistance) {
+            continue; // Leaf whose length alone rules it out; no distance needed for routing
+        }
+        int distance = editDistance(peq, patternLength, node->key);
+
+        // Deleted or renamed medications stay in the tree for routing but never match
+        if (distance <= maxDistance && resolveHandle(node->handle) != NULL &&
+            !appendFuzzyMatch(&matches, &matchCount, &matchCapacity, node->handle, distance)) {
+            break;
+        }
+
+        int lastChild = node->firstChild + node->childCount;
+        for (int child = node->firstChild; child < lastChild; child++) {
+            int edge = fuzzyIndex.packedEdges[child];
+            if (edge >= distance - maxDistance && edge <= distance + maxDistance) {
+                fuzzyIndex.pending[pendingCount++] = child;
+            }
+        }
+    }
+
+    for (int i = fuzzyIndex.packedCount; i < fuzzyIndex.count; i++) {
+        FuzzyNode* node = &fuzzyIndex.nodes[i];
+        int lengthGap = node->keyLength > patternLength ? node->keyLength - patternLength : patternLength - node->keyLength;
+        if (lengthGap > maxDistance) {
+            continue;
+        }
+        int distance = editDistance(peq, patternLength, node->key);
+        if (distance <= maxDistance && resolveHandle(node->handle) != NULL &&
+            !appendFuzzyMatch(&matches, &matchCount, &matchCapacity, node->handle, distance)) {
+            break;
+        }
+    }
+
+    // Rank by distance; insertion sort keeps equal distances in tree order
+    for (int i = 1; i < matchCount; i++) {
+        FuzzyMatch key = matches[i];
+        int j = i - 1;
+        while (j >= 0 && matches[j].distance > key.distance) {
+            matches[j + 1] = matches[j];
+            j--;
+        }
+        matches[j + 1] = key;
+    }
+
+    if (matchCount == 0) {
+        printf("No medications found matching '%s'\n", searchName);
+    }
+    for (int i = 0; i < matchCount; i++) {
+        printf("\n--- Match %d (%d edit%s away) ---", i + 1, matches[i].distance, matches[i].distance == 1 ? "" : "s");
+        displayMedication(*resolveHandle(matches[i].handle));
+    }
+    free(matches);
+}
+
+void sortMedications() {
+    int count = getMedicationCount();
+    if (count == 0) {
+        printf("No medications to sort!\n");
+        return;
+    }
+    
+    Medication* medArray = (Medication*)malloc(count * sizeof(Medication)); // Create an array of Medication structures (26)
+
+    // Populate the array from the linked list
+    MedicationNode* current = medicationList;
+    int i = 0;
+    
+    while (current != NULL) {
+        medArray[i++] = current->med; // Assign structure to array element (27) 
+        current = current->next;
     }
     
     // Provides the user with multiple options for sorting 
@@ -624,21 +1692,37 @@ void sortMedications() {
     
     int sortBy;
     scanf("%d", &sortBy);
+    if (sortBy < SORT_BY_NAME || sortBy > SORT_BY_QUANTITY) {
+        printf("Invalid sorting category!\n");
+        free(medArray);
+        return;
+    }
+    
+    printf("\nChoose sorting order:\n");
+    printf("1. Ascending\n2. Descending\n");
+    printf("Enter choice (1-2): ");
+    
+    int order;
+    scanf("%d", &order);
+    int descending = order == 2;
     
     // Provides the user with multiple options for sorting algorithms 
     printf("\nChoose sorting algorithm:\n");
-    printf("1. Bubble Sort\n2. Selection Sort\n");
-    printf("Enter choice (1-2): ");
+    printf("1. Bubble Sort (stable)\n2. Selection Sort\n3. Insertion Sort (stable)\n");
+    printf("Enter choice (1-3): ");
     
     int algorithm;
     scanf("%d", &algorithm);
     
     if (algorithm == 1) {
-        bubbleSort(medArray, count, sortBy);
+        bubbleSort(medArray, count, sortBy, descending);
         printf("\nMedications sorted using Bubble Sort:\n");
     } else if (algorithm == 2) {
-        selectionSort(medArray, count, sortBy);
+        selectionSort(medArray, count, sortBy, descending);
         printf("\nMedications sorted using Selection Sort:\n");
+    } else if (algorithm == 3) {
+        insertionSort(medArray, count, sortBy, descending);
+        printf("\nMedications sorted using Insertion Sort:\n");
     } else {
         printf("Invalid algorithm choice!\n");
         free(medArray);
@@ -649,64 +1733,184 @@ void sortMedications() {
     free(medArray);
 }
 
-// Bubble Sort and Selection Sort implementations
-void bubbleSort(Medication arr[], int n, int sortBy) {
+// Bubble Sort, Selection Sort and Insertion Sort implementations
+// Each sort key and direction gets its own kernel, generated from the comparison macros
+// below, so the inner loops compare fields directly instead of switching on sortBy for
+// every pair. The public sort functions pick the kernel once per call.
+
+// "a comes before b" for each key; a and b are Medication pointers
+#define NAME_ASC(a, b)      (strcmp((a)->name, (b)->name) < 0)       // Access structure element (28)
+#define NAME_DESC(a, b)     (strcmp((a)->name, (b)->name) > 0)
+#define PRICE_ASC(a, b)     ((a)->price < (b)->price)                // Access structure element (29)
+#define PRICE_DESC(a, b)    ((a)->price > (b)->price)
+#define QUANTITY_ASC(a, b)  ((a)->quantity < (b)->quantity)          // Access structure element (30)
+#define QUANTITY_DESC(a, b) ((a)->quantity > (b)->quantity)
+
+// Strict comparisons keep bubble and insertion sort stable: equal keys never move past each other
+#define DEFINE_SORT_KERNELS(suffix, BEFORE)                                   \
+void bubbleSort##suffix(Medication arr[], int n) {                           \
+    for (int i = 0; i < n - 1; i++) {                                        \
+        for (int j = 0; j < n - i - 1; j++) {                                \
+            if (BEFORE(&arr[j + 1], &arr[j])) {                              \
+                Medication temp = arr[j]; /* Structure assignment (31) */   \
+                arr[j] = arr[j + 1];      /* Structure assignment (32) */   \
+                arr[j + 1] = temp;        /* Structure assignment (33) */   \
+            }                                                                \
+        }                                                                    \
+    }                                                                        \
+}                                                                            \
+void selectionSort##suffix(Medication arr[], int n) {                        \
+    for (int i = 0; i < n - 1; i++) {                                        \
+        int minIndex = i;                                                    \
+        for (int j = i + 1; j < n; j++) {                                    \
+            if (BEFORE(&arr[j], &arr[minIndex])) {                           \
+                minIndex = j;                                                \
+            }                                                                \
+        }                                                                    \
+        if (minIndex != i) {                                                 \
+            Medication temp = arr[i];                                        \
+            arr[i] = arr[minIndex];                                          \
+            arr[minIndex] = temp;                                            \
+        }                                                                    \
+    }                                                                        \
+}                                                                            \
+void insertionSort##suffix(Medication arr[], int n) {                        \
+    for (int i = 1; i < n; i++) {                                            \
+        Medication key = arr[i];                                             \
+        int j = i - 1;                                                       \
+        while (j >= 0 && BEFORE(&key, &arr[j])) {                            \
+            arr[j + 1] = arr[j];                                             \
+            j--;                                                             \
+        }                                                                    \
+        arr[j + 1] = key;                                                    \
+    }                                                                        \
+}
+
+DEFINE_SORT_KERNELS(ByNameAsc, NAME_ASC)
+DEFINE_SORT_KERNELS(ByNameDesc, NAME_DESC)
+DEFINE_SORT_KERNELS(ByPriceAsc, PRICE_ASC)
+DEFINE_SORT_KERNELS(ByPriceDesc, PRICE_DESC)
+DEFINE_SORT_KERNELS(ByQuantityAsc, QUANTITY_ASC)
+DEFINE_SORT_KERNELS(ByQuantityDesc, QUANTITY_DESC)
+
+typedef void (*SortKernel)(Medication arr[], int n);
+
+// Indexed by [sortBy - 1][descending]
+SortKernel bubbleSortKernels[3][2] = {
+    {bubbleSortByNameAsc, bubbleSortByNameDesc},
+    {bubbleSortByPriceAsc, bubbleSortByPriceDesc},
+    {bubbleSortByQuantityAsc, bubbleSortByQuantityDesc}
+};
+SortKernel selectionSortKernels[3][2] = {
+    {selectionSortByNameAsc, selectionSortByNameDesc},
+    {selectionSortByPriceAsc, selectionSortByPriceDesc},
+    {selectionSortByQuantityAsc, selectionSortByQuantityDesc}
+};
+SortKernel insertionSortKernels[3][2] = {
+    {insertionSortByNameAsc, insertionSortByNameDesc},
+    {insertionSortByPriceAsc, insertionSortByPriceDesc},
+    {insertionSortByQuantityAsc, insertionSortByQuantityDesc}
+};
+
+void bubbleSort(Medication arr[], int n, int sortBy, int descending) {
+    if (sortBy >= SORT_BY_NAME && sortBy <= SORT_BY_QUANTITY) {
+        bubbleSortKernels[sortBy - 1][descending != 0](arr, n);
+    }
+}
+
+void selectionSort(Medication arr[], int n, int sortBy, int descending) {
+    if (sortBy >= SORT_BY_NAME && sortBy <= SORT_BY_QUANTITY) {
+        selectionSortKernels[sortBy - 1][descending != 0](arr, n);
+    }
+}
+
+void insertionSort(Medication arr[], int n, int sortBy, int descending) {
+    if (sortBy >= SORT_BY_NAME && sortBy <= SORT_BY_QUANTITY) {
+        insertionSortKernels[sortBy - 1][descending != 0](arr, n);
+    }
+}
+
+// Reference bubble sort that evaluates switch (sortBy) for every pair, as the sort
+// routines used to; only kept so the benchmark has a baseline
+void bubbleSortGeneric(Medication arr[], int n, int sortBy) {
     for (int i = 0; i < n - 1; i++) {
         for (int j = 0; j < n - i - 1; j++) {
             int shouldSwap = 0;
             
             switch (sortBy) {
-                case 1: // Sort by Name 
-                    shouldSwap = strcmp(arr[j].name, arr[j + 1].name) > 0;   // Access structure element (28)
+                case SORT_BY_NAME:
+                    shouldSwap = strcmp(arr[j].name, arr[j + 1].name) > 0;
                     break;
-                case 2: // Sort by Price
-                    shouldSwap = arr[j].price > arr[j + 1].price;           // Access structure element (29) 
+                case SORT_BY_PRICE:
+                    shouldSwap = arr[j].price > arr[j + 1].price;
                     break;
-                case 3: // Sort by Quantity
-                    shouldSwap = arr[j].quantity > arr[j + 1].quantity;    // Access structure element (30) 
+                case SORT_BY_QUANTITY:
+                    shouldSwap = arr[j].quantity > arr[j + 1].quantity;
                     break;
             }
             
             if (shouldSwap) {
-                Medication temp = arr[j]; // Structure assignment (31) 
-                arr[j] = arr[j + 1]; // Structure assignment (32) 
-                arr[j + 1] = temp; // Structure assignment (33) 
+                Medication temp = arr[j];
+                arr[j] = arr[j + 1];
+                arr[j + 1] = temp;
             }
         }
     }
 }
 
-// Selection Sort implementation 
-void selectionSort(Medication arr[], int n, int sortBy) {
-    for (int i = 0; i < n - 1; i++) {
-        int minIndex = i;
-        
-        for (int j = i + 1; j < n; j++) {
-            int shouldSelect = 0;
-            
-            switch (sortBy) {
-                case 1:
-                    shouldSelect = strcmp(arr[j].name, arr[minIndex].name) < 0;
-                    break;
-                case 2:
-                    shouldSelect = arr[j].price < arr[minIndex].price;
-                    break;
-                case 3:
-                    shouldSelect = arr[j].quantity < arr[minIndex].quantity;
-                    break;
-            }
-            
-            if (shouldSelect) {
-                minIndex = j;
-            }
-        }
-        
-        if (minIndex != i) {
-            Medication temp = arr[i];
-            arr[i] = arr[minIndex];
-            arr[minIndex] = temp;
+double timeSortRun(Medication* work, const Medication* source, int n, int sortBy, SortKernel kernel) {
+    memcpy(work, source, n * sizeof(Medication));
+    clock_t start = clock();
+    if (kernel != NULL) {
+        kernel(work, n);
+    } else {
+        bubbleSortGeneric(work, n, sortBy);
+    }
+    return (double)(clock() - start) / CLOCKS_PER_SEC;
+}
+
+void runSortBenchmark(int n) {
+    if (n < 2) {
+        printf("Benchmark needs at least 2 medications!\n");
+        return;
+    }
+
+    Medication* source = (Medication*)malloc(n * sizeof(Medication));
+    Medication* work = (Medication*)malloc(n * sizeof(Medication));
+    if (source == NULL || work == NULL) {
+        printf("Memory allocation failed!\n");
+        free(source);
+        free(work);
+        return;
+    }
+
+    srand(42);
+    for (int i = 0; i < n; i++) {
+        memset(&source[i], 0, sizeof(Medication));
+        source[i].medicationId = i + 1;
+        for (int k = 0; k < 8; k++) {
+            source[i].name[k] = (char)('A' + rand() % 26);
         }
+        source[i].quantity = rand() % 500;
+        source[i].price = (float)(rand() % 10000) / 100.0f;
+    }
+
+    // Bubble sort always performs n(n-1)/2 comparisons, so time per comparison is comparable
+    double comparisons = (double)n * (n - 1) / 2.0;
+    const char* keyNames[3] = {"Name", "Price", "Quantity"};
+
+    printf("=== SORT BENCHMARK (Bubble Sort, %d medications) ===\n", n);
+    printf("%-10s %16s %16s %10s\n", "Key", "switch ns/cmp", "kernel ns/cmp", "speedup");
+    for (int sortBy = SORT_BY_NAME; sortBy <= SORT_BY_QUANTITY; sortBy++) {
+        double generic = timeSortRun(work, source, n, sortBy, NULL);
+        double specialized = timeSortRun(work, source, n, sortBy, bubbleSortKernels[sortBy - 1][0]);
+        printf("%-10s %16.2f %16.2f %9.2fx\n", keyNames[sortBy - 1],
+               generic * 1e9 / comparisons, specialized * 1e9 / comparisons,
+               specialized > 0 ? generic / specialized : 0.0);
     }
+
+    free(source);
+    free(work);
 }
 
 // After sorting, display the sorted medications list to the user  
@@ -742,17 +1946,722 @@ void cleanupSystem() {
         current = next;
     }
     medicationList = NULL;
+    free(medicationStore.slots);
+    medicationStore.slots = NULL;
+    medicationStore.capacity = 0;
+    medicationStore.used = 0;
+    medicationStore.freeHead = NO_FREE_SLOT;
+    free(medicationIdIndex.entries);
+    memset(&medicationIdIndex, 0, sizeof(medicationIdIndex));
+    free(fuzzyIndex.nodes);
+    free(fuzzyIndex.packed);
+    free(fuzzyIndex.packedEdges);
+    free(fuzzyIndex.pending);
+    memset(&fuzzyIndex, 0, sizeof(fuzzyIndex));
+    free(consumptionForecast.handles);
+    free(consumptionForecast.quantity);
+    free(consumptionForecast.dailyUse);
+    free(consumptionForecast.refillSupply);
+    free(consumptionForecast.runOutDay);
+    free(consumptionForecast.exhaustionDay);
+    memset(&consumptionForecast, 0, sizeof(consumptionForecast));
     printf("System Cleanup complete. All Memory Freed.\n");
 }
 
 // Adding a function to prevent duplicate medication IDs
 int isDuplicateId(int medicationId) {
-    MedicationNode* current = medicationList;
-    while (current != NULL) {
-        if (current->med.medicationId == medicationId) { // Access nested structure element (35) 
-            return 1; // ID already exists
+    return findMedicationById(medicationId) != NULL; // O(1) lookup through the ID index
+}
+
+// ===== IPC SERVER MODE =====
+// Serves the medication store over a Unix domain socket so several terminals share
+// one in-memory inventory. Line protocol, one request per line:
+//   PING                                       -> OK 0
+//   COUNT                                      -> OK 1, then the count
+//   GET id [id ...]                            -> OK n, then one record line per id
+//   ADD id|name|dosage|qty|price|refills|date[|dosesPerDay|tabletsPerDose|tabletsPerRefill]
+//                                              -> OK 0 or ERR <reason>
+//   SETQTY id qty [id qty ...]                 -> OK 1, then the number of records updated
+//   DEL id                                     -> OK 0 or ERR <reason>
+// Record lines are "id|name|dosage|qty|price|refills|date|dosesPerDay|tabletsPerDose|tabletsPerRefill"
+// or "id|NOTFOUND".
+// GET and SETQTY take at most SERVER_MAX_BATCH IDs or pairs; a longer or malformed batch
+// gets an ERR and nothing in it is applied.
+// Clients may pipeline requests; replies come back in request order.
+#ifdef __linux__
+
+#define SERVER_MAX_EVENTS 64
+#define SERVER_MAX_LINE 8192
+#define SERVER_MAX_BATCH 256
+#define SERVER_MAX_PENDING_OUTPUT (1 << 20) // Stop reading a client whose unsent replies pass this
+#define LOADGEN_SEED_COUNT 1000
+#define LOADGEN_FIRST_ID 100000
+#define LOADGEN_PIPELINE_DEPTH 64
+
+typedef struct {
+    int fd;
+    char in[SERVER_MAX_LINE];
+    size_t inLength;
+    char* out;             // Replies waiting to be sent
+    size_t outLength;
+    size_t outSent;
+    size_t outCapacity;
+    unsigned int events;   // Events currently registered with epoll
+    int readClosed;        // Client half-closed; close once the remaining replies are sent
+    int readPaused;        // Too many unsent replies; wait for the client to read some
+    int failed;            // A reply could not be buffered; the stream is no longer framed
+} ServerConnection; // Per-client state for the epoll loop
+
+typedef struct {
+    int fd;
+    char buffer[65536];
+    size_t length;
+    size_t position;
+} ReplyReader; // Buffered line reader used by the load generator
+
+volatile sig_atomic_t serverRunning = 1;
+
+void stopServer(int signalNumber) {
+    (void)signalNumber;
+    serverRunning = 0;
+}
+
+// Appends formatted text to the connection's reply buffer, growing it as needed
+int appendReply(ServerConnection* conn, const char* format, ...) {
+    for (;;) {
+        size_t space = conn->outCapacity - conn->outLength;
+        va_list args;
+        va_start(args, format);
+        int written = vsnprintf(conn->out + conn->outLength, space, format, args);
+        va_end(args);
+
+        if (written < 0) {
+            conn->failed = 1;
+            return 0;
         }
-        current = current->next;
+        if ((size_t)written < space) {
+            conn->outLength += written;
+            return 1;
+        }
+
+        size_t newCapacity = conn->outCapacity == 0 ? 4096 : conn->outCapacity * 2;
+        while (newCapacity - conn->outLength <= (size_t)written) {
+            newCapacity *= 2;
+        }
+        char* grown = (char*)realloc(conn->out, newCapacity);
+        if (grown == NULL) {
+            conn->failed = 1;
+            return 0;
+        }
+        conn->out = grown;
+        conn->outCapacity = newCapacity;
     }
-    return 0; // ID is unique 
-}
\ No newline at end of file
+}
+
+void appendRecord(ServerConnection* conn, int medicationId, const Medication* med) {
+    if (med == NULL) {
+        appendReply(conn, "%d|NOTFOUND\n", medicationId);
+        return;
+    }
+    appendReply(conn, "%d|%s|%s|%d|%.2f|%d|%s|%d|%.2f|%d\n", med->medicationId, med->name, med->dosage,
+                med->quantity, med->price, med->refill.refillsRemaining, med->refill.nextRefillDate,
+                med->schedule.dosesPerDay, med->schedule.tabletsPerDose, med->refill.tabletsPerRefill);
+}
+
+// Returns 1 when nothing but whitespace is left in a request's arguments
+int isBlankArgs(const char* args) {
+    while (isspace((unsigned char)*args)) {
+        args++;
+    }
+    return *args == '\0';
+}
+
+// Multi-get: resolves every requested ID through the ID index
+void handleGetRequest(ServerConnection* conn, char* args) {
+    int ids[SERVER_MAX_BATCH];
+    Medication* found[SERVER_MAX_BATCH];
+    int count = 0;
+    char* end;
+
+    for (long value = strtol(args, &end, 10); end != args; value = strtol(args, &end, 10)) {
+        if (count == SERVER_MAX_BATCH) {
+            appendReply(conn, "ERR batch too large (max %d)\n", SERVER_MAX_BATCH);
+            return;
+        }
+        ids[count] = (int)value;
+        found[count] = NULL;
+        count++;
+        args = end;
+    }
+    if (!isBlankArgs(args)) {
+        appendReply(conn, "ERR GET expects numeric IDs\n");
+        return;
+    }
+    if (count == 0) {
+        appendReply(conn, "ERR GET needs at least one ID\n");
+        return;
+    }
+
+    for (int i = 0; i < count; i++) {
+        found[i] = findMedicationById(ids[i]);
+    }
+
+    appendReply(conn, "OK %d\n", count);
+    for (int i = 0; i < count; i++) {
+        appendRecord(conn, ids[i], found[i]);
+    }
+}
+
+// Bulk update: validates every (id, quantity) pair first, then applies them through the ID index;
+// an oversized or malformed batch is rejected whole
+void handleSetQuantityRequest(ServerConnection* conn, char* args) {
+    int ids[SERVER_MAX_BATCH];
+    int quantities[SERVER_MAX_BATCH];
+    int count = 0;
+    char* end;
+
+    for (;;) {
+        long id = strtol(args, &end, 10);
+        if (end == args) {
+            break;
+        }
+        if (count == SERVER_MAX_BATCH) {
+            appendReply(conn, "ERR batch too large (max %d)\n", SERVER_MAX_BATCH);
+            return;
+        }
+        args = end;
+        errno = 0;
+        long quantity = strtol(args, &end, 10);
+        if (end == args) {
+            appendReply(conn, "ERR SETQTY expects id/quantity pairs\n");
+            return;
+        }
+        if (errno == ERANGE || quantity < 0 || quantity > INT_MAX) {
+            appendReply(conn, "ERR Quantity must be between 0 and %d\n", INT_MAX);
+            return;
+        }
+        args = end;
+        ids[count] = (int)id;
+        quantities[count] = (int)quantity;
+        count++;
+    }
+    if (!isBlankArgs(args)) {
+        appendReply(conn, "ERR SETQTY expects id/quantity pairs\n");
+        return;
+    }
+    if (count == 0) {
+        appendReply(conn, "ERR SETQTY needs at least one id/quantity pair\n");
+        return;
+    }
+
+    int updated = 0;
+    for (int i = 0; i < count; i++) {
+        Medication* med = findMedicationById(ids[i]);
+        if (med != NULL) {
+            med->quantity = quantities[i];
+            updated++;
+        }
+    }
+
+    appendReply(conn, "OK 1\n%d\n", updated);
+}
+
+void handleAddRequest(ServerConnection* conn, char* args) {
+    Medication med;
+    memset(&med, 0, sizeof(med));
+
+    long quantity = 0; // Read wide so an out-of-range quantity is caught rather than wrapped
+    int fields = sscanf(args, " %d|%49[^|]|%19[^|]|%ld|%f|%d|%11[^|]|%d|%f|%d", &med.medicationId, med.name,
+                        med.dosage, &quantity, &med.price, &med.refill.refillsRemaining, med.refill.nextRefillDate,
+                        &med.schedule.dosesPerDay, &med.schedule.tabletsPerDose, &med.refill.tabletsPerRefill);
+    if (fields != 7 && fields != 10) {
+        appendReply(conn, "ERR ADD expects id|name|dosage|qty|price|refills|date[|doses|perDose|perRefill]\n");
+        return;
+    }
+    if (quantity < 0 || quantity > INT_MAX) {
+        appendReply(conn, "ERR Quantity must be between 0 and %d\n", INT_MAX);
+        return;
+    }
+    med.quantity = (int)quantity;
+    if (med.schedule.dosesPerDay < 0 || med.schedule.tabletsPerDose < 0 || med.refill.tabletsPerRefill < 0) {
+        appendReply(conn, "ERR Dosing schedule and tablets per refill cannot be negative\n");
+        return;
+    }
+    if (isDuplicateId(med.medicationId)) {
+        appendReply(conn, "ERR Medication ID %d already exists\n", med.medicationId);
+        return;
+    }
+    if (storeMedication(med).generation == 0) {
+        appendReply(conn, "ERR Memory allocation failed\n");
+        return;
+    }
+    appendReply(conn, "OK 0\n");
+}
+
+void handleDeleteRequest(ServerConnection* conn, char* args) {
+    int medicationId;
+    if (sscanf(args, "%d", &medicationId) != 1) {
+        appendReply(conn, "ERR DEL needs an ID\n");
+        return;
+    }
+
+    MedicationNode* node = unlinkMedication(medicationId);
+    if (node == NULL) {
+        appendReply(conn, "ERR Medication with ID %d not found\n", medicationId);
+        return;
+    }
+    releaseHandle(node->handle);
+    free(node);
+    appendReply(conn, "OK 0\n");
+}
+
+void handleRequestLine(ServerConnection* conn, char* line) {
+    char* args = line;
+    while (*args != '\0' && *args != ' ') {
+        args++;
+    }
+    if (*args == ' ') {
+        *args++ = '\0';
+    }
+
+    if (strcmp(line, "GET") == 0) {
+        handleGetRequest(conn, args);
+    } else if (strcmp(line, "SETQTY") == 0) {
+        handleSetQuantityRequest(conn, args);
+    } else if (strcmp(line, "ADD") == 0) {
+        handleAddRequest(conn, args);
+    } else if (strcmp(line, "DEL") == 0) {
+        handleDeleteRequest(conn, args);
+    } else if (strcmp(line, "COUNT") == 0) {
+        appendReply(conn, "OK 1\n%d\n", getMedicationCount());
+    } else if (strcmp(line, "PING") == 0) {
+        appendReply(conn, "OK 0\n");
+    } else {
+        appendReply(conn, "ERR Unknown command '%s'\n", line);
+    }
+}
+
+// Registers EPOLLIN unless reading is closed or paused, and EPOLLOUT while replies are pending
+void updateConnectionEvents(int epollFd, ServerConnection* conn) {
+    unsigned int events = 0;
+    if (!conn->readClosed && !conn->readPaused) {
+        events |= EPOLLIN;
+    }
+    if (conn->outSent < conn->outLength) {
+        events |= EPOLLOUT;
+    }
+    if (events != conn->events) {
+        struct epoll_event event;
+        event.events = events;
+        event.data.ptr = conn;
+        epoll_ctl(epollFd, EPOLL_CTL_MOD, conn->fd, &event);
+        conn->events = events;
+    }
+}
+
+void closeConnection(int epollFd, ServerConnection* conn) {
+    epoll_ctl(epollFd, EPOLL_CTL_DEL, conn->fd, NULL);
+    close(conn->fd);
+    free(conn->out);
+    free(conn);
+}
+
+// Sends as much of the reply buffer as the socket accepts; returns 0 when the connection
+// should be closed (client gone, or client half-closed and every reply delivered)
+int flushConnection(int epollFd, ServerConnection* conn) {
+    while (conn->outSent < conn->outLength) {
+        ssize_t sent = send(conn->fd, conn->out + conn->outSent, conn->outLength - conn->outSent, MSG_NOSIGNAL);
+        if (sent < 0) {
+            if (errno == EINTR) {
+                continue;
+            }
+            if (errno != EAGAIN && errno != EWOULDBLOCK) {
+                return 0;
+            }
+            break;
+        }
+        conn->outSent += sent;
+    }
+
+    int pending = conn->outSent < conn->outLength;
+    if (!pending) {
+        conn->outLength = 0;
+        conn->outSent = 0;
+        if (conn->readClosed) {
+            return 0;
+        }
+    }
+    if (conn->readPaused && conn->outLength - conn->outSent < SERVER_MAX_PENDING_OUTPUT / 2) {
+        conn->readPaused = 0; // Client caught up; start taking requests again
+    }
+    updateConnectionEvents(epollFd, conn);
+    return 1;
+}
+
+// Drains the socket, runs every complete request line, then answers the whole batch at once
+int readConnection(int epollFd, ServerConnection* conn) {
+    for (;;) {
+        ssize_t received = recv(conn->fd, conn->in + conn->inLength, SERVER_MAX_LINE - conn->inLength, 0);
+        if (received == 0) {
+            // Client half-closed: every complete line has been handled, so send the replies
+            // and close once they are out (a trailing partial line is dropped)
+            conn->readClosed = 1;
+            break;
+        }
+        if (received < 0) {
+            if (errno == EINTR) {
+                continue;
+            }
+            if (errno == EAGAIN || errno == EWOULDBLOCK) {
+                break;
+            }
+            return 0;
+        }
+        conn->inLength += received;
+
+        size_t start = 0;
+        char* newline;
+        while ((newline = (char*)memchr(conn->in + start, '\n', conn->inLength - start)) != NULL) {
+            *newline = '\0';
+            if (newline > conn->in + start && newline[-1] == '\r') {
+                newline[-1] = '\0';
+            }
+            handleRequestLine(conn, conn->in + start);
+            if (conn->failed) {
+                return 0;
+            }
+            start = (size_t)(newline - conn->in) + 1;
+        }
+        memmove(conn->in, conn->in + start, conn->inLength - start);
+        conn->inLength -= start;
+
+        if (conn->outLength - conn->outSent >= SERVER_MAX_PENDING_OUTPUT) {
+            conn->readPaused = 1; // Leave further requests in the socket until replies drain
+            break;
+        }
+
+        if (conn->inLength == SERVER_MAX_LINE) {
+            appendReply(conn, "ERR Request line too long\n");
+            flushConnection(epollFd, conn);
+            return 0;
+        }
+    }
+
+    return flushConnection(epollFd, conn);
+}
+
+void acceptConnections(int epollFd, int listenFd) {
+    for (;;) {
+        int clientFd = accept4(listenFd, NULL, NULL, SOCK_NONBLOCK | SOCK_CLOEXEC);
+        if (clientFd < 0) {
+            if (errno == EINTR) {
+                continue;
+            }
+            return; // EAGAIN: no more pending clients
+        }
+
+        ServerConnection* conn = (ServerConnection*)calloc(1, sizeof(ServerConnection));
+        if (conn == NULL) {
+            close(clientFd);
+            continue;
+        }
+        conn->fd = clientFd;
+        conn->events = EPOLLIN;
+
+        struct epoll_event event;
+        event.events = EPOLLIN;
+        event.data.ptr = conn;
+        if (epoll_ctl(epollFd, EPOLL_CTL_ADD, clientFd, &event) < 0) {
+            close(clientFd);
+            free(conn);
+        }
+    }
+}
+
+int runServer(const char* socketPath) {
+    struct sockaddr_un address;
+    if (strlen(socketPath) >= sizeof(address.sun_path)) {
+        printf("Socket path is too long: %s\n", socketPath);
+        return 1;
+    }
+
+    int listenFd = socket(AF_UNIX, SOCK_STREAM | SOCK_NONBLOCK | SOCK_CLOEXEC, 0);
+    if (listenFd < 0) {
+        perror("socket");
+        return 1;
+    }
+
+    memset(&address, 0, sizeof(address));
+    address.sun_family = AF_UNIX;
+    strcpy(address.sun_path, socketPath);
+    unlink(socketPath); // Remove a stale socket left by a previous run
+
+    if (bind(listenFd, (struct sockaddr*)&address, sizeof(address)) < 0 || listen(listenFd, SOMAXCONN) < 0) {
+        perror("bind/listen");
+        close(listenFd);
+        return 1;
+    }
+
+    int epollFd = epoll_create1(EPOLL_CLOEXEC);
+    if (epollFd < 0) {
+        perror("epoll_create1");
+        close(listenFd);
+        unlink(socketPath);
+        return 1;
+    }
+
+    struct epoll_event event;
+    event.events = EPOLLIN;
+    event.data.ptr = NULL; // NULL marks the listening socket
+    epoll_ctl(epollFd, EPOLL_CTL_ADD, listenFd, &event);
+
+    signal(SIGINT, stopServer);
+    signal(SIGTERM, stopServer);
+
+    printf("Medication server listening on %s (Ctrl+C to stop)\n", socketPath);
+    fflush(stdout);
+
+    struct epoll_event events[SERVER_MAX_EVENTS];
+    while (serverRunning) {
+        int ready = epoll_wait(epollFd, events, SERVER_MAX_EVENTS, -1);
+        if (ready < 0) {
+            if (errno == EINTR) {
+                continue;
+            }
+            perror("epoll_wait");
+            break;
+        }
+
+        for (int i = 0; i < ready; i++) {
+            ServerConnection* conn = (ServerConnection*)events[i].data.ptr;
+            if (conn == NULL) {
+                acceptConnections(epollFd, listenFd);
+                continue;
+            }
+
+            int alive = 1;
+            int hangup = (events[i].events & (EPOLLERR | EPOLLHUP)) != 0;
+            if (events[i].events & EPOLLOUT) {
+                alive = flushConnection(epollFd, conn);
+            }
+            // Drain whatever the client sent before a hangup so its requests still get answered
+            if (alive && !conn->readClosed && !conn->readPaused && ((events[i].events & EPOLLIN) || hangup)) {
+                alive = readConnection(epollFd, conn);
+            }
+            if (alive && hangup) {
+                alive = 0;
+            }
+            if (!alive) {
+                closeConnection(epollFd, conn);
+            }
+        }
+    }
+
+    close(epollFd);
+    close(listenFd);
+    unlink(socketPath);
+    printf("\nMedication server stopped.\n");
+    cleanupSystem();
+    return 0;
+}
+
+// ===== LOAD GENERATOR =====
+
+int sendAll(int fd, const char* data, size_t length) {
+    while (length > 0) {
+        ssize_t sent = send(fd, data, length, MSG_NOSIGNAL);
+        if (sent < 0) {
+            if (errno == EINTR) {
+                continue;
+            }
+            return 0;
+        }
+        data += sent;
+        length -= sent;
+    }
+    return 1;
+}
+
+// Reads one reply line (without the newline); returns 0 when the server hangs up
+int readReplyLine(ReplyReader* reader, char* line, size_t maxLength) {
+    for (;;) {
+        char* newline = (char*)memchr(reader->buffer + reader->position, '\n', reader->length - reader->position);
+        if (newline != NULL) {
+            size_t length = (size_t)(newline - (reader->buffer + reader->position));
+            if (length >= maxLength) {
+                length = maxLength - 1;
+            }
+            memcpy(line, reader->buffer + reader->position, length);
+            line[length] = '\0';
+            reader->position = (size_t)(newline - reader->buffer) + 1;
+            return 1;
+        }
+
+        memmove(reader->buffer, reader->buffer + reader->position, reader->length - reader->position);
+        reader->length -= reader->position;
+        reader->position = 0;
+        if (reader->length == sizeof(reader->buffer)) {
+            return 0; // Line longer than the whole buffer
+        }
+
+        ssize_t received = recv(reader->fd, reader->buffer + reader->length, sizeof(reader->buffer) - reader->length, 0);
+        if (received < 0 && errno == EINTR) {
+            continue;
+        }
+        if (received <= 0) {
+            return 0;
+        }
+        reader->length += received;
+    }
+}
+
+// Reads a full reply ("OK n" plus n lines, or "ERR ..."); returns the number of data lines or -1
+int readReply(ReplyReader* reader) {
+    char line[512];
+    if (!readReplyLine(reader, line, sizeof(line))) {
+        return -1;
+    }
+    if (strncmp(line, "OK ", 3) != 0) {
+        return 0;
+    }
+
+    int lines = atoi(line + 3);
+    for (int i = 0; i < lines; i++) {
+        if (!readReplyLine(reader, line, sizeof(line))) {
+            return -1;
+        }
+    }
+    return lines;
+}
+
+double elapsedSeconds(struct timespec start) {
+    struct timespec now;
+    clock_gettime(CLOCK_MONOTONIC, &now);
+    return (now.tv_sec - start.tv_sec) + (now.tv_nsec - start.tv_nsec) / 1e9;
+}
+
+int runLoadGenerator(const char* socketPath, int requests, int batchSize) {
+    struct sockaddr_un address;
+    if (strlen(socketPath) >= sizeof(address.sun_path)) {
+        printf("Socket path is too long: %s\n", socketPath);
+        return 1;
+    }
+    if (requests <= 0 || batchSize <= 0 || batchSize > SERVER_MAX_BATCH / 2) {
+        printf("Requests must be positive and batch size between 1 and %d\n", SERVER_MAX_BATCH / 2);
+        return 1;
+    }
+
+    int fd = socket(AF_UNIX, SOCK_STREAM | SOCK_CLOEXEC, 0);
+    if (fd < 0) {
+        perror("socket");
+        return 1;
+    }
+    memset(&address, 0, sizeof(address));
+    address.sun_family = AF_UNIX;
+    strcpy(address.sun_path, socketPath);
+    if (connect(fd, (struct sockaddr*)&address, sizeof(address)) < 0) {
+        perror("connect");
+        close(fd);
+        return 1;
+    }
+
+    ReplyReader* reader = (ReplyReader*)malloc(sizeof(ReplyReader));
+    size_t requestCapacity = (size_t)LOADGEN_PIPELINE_DEPTH * (16 + batchSize * 24);
+    char* requestBuffer = (char*)malloc(requestCapacity);
+    if (reader == NULL || requestBuffer == NULL) {
+        printf("Memory allocation failed!\n");
+        free(reader);
+        free(requestBuffer);
+        close(fd);
+        return 1;
+    }
+    reader->fd = fd;
+    reader->length = 0;
+    reader->position = 0;
+
+    // Seed the store with a known ID range; IDs already present are simply reported as duplicates
+    int failed = 0;
+    for (int i = 0; i < LOADGEN_SEED_COUNT && !failed; i++) {
+        char line[128];
+        int id = LOADGEN_FIRST_ID + i;
+        int length = snprintf(line, sizeof(line), "ADD %d|LoadMed%d|10mg|100|1.00|3|01/01/2030\n", id, id);
+        failed = !sendAll(fd, line, length);
+    }
+    for (int i = 0; i < LOADGEN_SEED_COUNT && !failed; i++) {
+        failed = readReply(reader) < 0;
+    }
+
+    // Keep up to LOADGEN_PIPELINE_DEPTH requests in flight; every fourth one is a bulk update
+    struct timespec start;
+    clock_gettime(CLOCK_MONOTONIC, &start);
+    unsigned int seed = 12345;
+    int sent = 0;
+    int completed = 0;
+    long records = 0;
+
+    while (completed < requests && !failed) {
+        size_t length = 0;
+        while (sent < requests && sent - completed < LOADGEN_PIPELINE_DEPTH) {
+            int isUpdate = (sent % 4) == 3;
+            length += snprintf(requestBuffer + length, requestCapacity - length, isUpdate ? "SETQTY" : "GET");
+            for (int i = 0; i < batchSize; i++) {
+                seed = seed * 1103515245u + 12345u;
+                int id = LOADGEN_FIRST_ID + (int)((seed >> 16) % LOADGEN_SEED_COUNT);
+                if (isUpdate) {
+                    length += snprintf(requestBuffer + length, requestCapacity - length, " %d %d", id, (int)(seed % 500));
+                } else {
+                    length += snprintf(requestBuffer + length, requestCapacity - length, " %d", id);
+                }
+            }
+            requestBuffer[length++] = '\n';
+            records += batchSize;
+            sent++;
+        }
+        if (length > 0 && !sendAll(fd, requestBuffer, length)) {
+            failed = 1;
+            break;
+        }
+
+        // Collect at least one reply, then whatever else is already buffered
+        do {
+            if (readReply(reader) < 0) {
+                failed = 1;
+                break;
+            }
+            completed++;
+        } while (completed < sent && reader->position < reader->length);
+    }
+
+    double seconds = elapsedSeconds(start);
+    if (failed) {
+        printf("Connection to the server was lost after %d requests.\n", completed);
+    } else {
+        printf("=== LOAD GENERATOR RESULTS ===\n");
+        printf("Requests: %d (batch size %d, pipeline depth %d)\n", completed, batchSize, LOADGEN_PIPELINE_DEPTH);
+        printf("Elapsed: %.3f s\n", seconds);
+        printf("Throughput: %.0f requests/s, %.0f records/s\n", completed / seconds, records / seconds);
+    }
+
+    free(requestBuffer);
+    free(reader);
+    close(fd);
+    return failed ? 1 : 0;
+}
+
+#else
+
+int runServer(const char* socketPath) {
+    (void)socketPath;
+    printf("Server mode needs Unix domain sockets and epoll (Linux only).\n");
+    return 1;
+}
+
+int runLoadGenerator(const char* socketPath, int requests, int batchSize) {
+    (void)socketPath;
+    (void)requests;
+    (void)batchSize;
+    printf("Load generator needs Unix domain sockets (Linux only).\n");
+    return 1;
+}
+
+#endif